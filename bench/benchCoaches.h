@@ -0,0 +1,50 @@
+#pragma once
+#include "../src/util.h"
+#include "../src/coaches/coachesOrg.h"
+
+// Runs the coaching carousel over the real set of schools for a number of offseasons, firing a share of each staff every
+// year to keep the market busy
+void benchCarousel(HiringMode mode, const char* label, int years, unsigned seed) {
+    std::srand(seed);
+    RNG::gen.seed(seed);
+    std::vector<School*> schools;
+    for (auto sd : GlobalData::getSchoolsData()) {
+        City* city = GlobalData::getCityByName(GlobalData::stateNameToCode(sd.state), sd.city);
+        schools.push_back(new School(sd.name, sd.mascot, sd.state, city, sd.prestige, sd.stadiumCapacity, sd.budget, sd.nflRating, sd.academicRating));
+    }
+    CoachesOrganization org;
+    org.setHiringMode(mode);
+    org.initializeAllCoaches();
+
+    auto start = std::chrono::steady_clock::now();
+    org.fillAllVacancies(schools);
+    double initial = elapsedMs(start);
+
+    double total = 0;
+    int walkons = 0;
+    for (int year = 0; year < years; year++) {
+        for (School* school : schools) {
+            for (int t = 0; t < 11; t++) {
+                Coach* coach = school->getCoach((CoachType)t);
+                if (coach == nullptr || std::rand() % 6 != 0) continue;
+                school->loseCoach((CoachType)t);
+                coach->resign(true);
+            }
+        }
+        org.advanceYear();
+        int before = org.getCoachCount();
+        start = std::chrono::steady_clock::now();
+        org.fillAllVacancies(schools);
+        total += elapsedMs(start);
+        walkons += org.getCoachCount() - before;
+    }
+    printf("%-18s initial %8.2f ms | per offseason %8.2f ms | walk-ons per offseason %6.1f\n", label, initial, total / years,
+        (double)walkons / years);
+    for (School* school : schools) delete school;
+}
+
+void benchCoaches(int years, unsigned seed) {
+    printf("\n===== COACHING CAROUSEL (%d offseasons) =====\n", years);
+    benchCarousel(HiringMode::GREEDY, "Greedy", years, seed);
+    benchCarousel(HiringMode::STABLE_MATCHING, "Stable matching", years, seed);
+}
@@ -0,0 +1,104 @@
+#pragma once
+#include "../src/league/league.h"
+
+#include <algorithm>
+
+// Largest gap between the two samples' cumulative distributions
+double ksStatistic(std::vector<int> a, std::vector<int> b) {
+    std::sort(a.begin(), a.end());
+    std::sort(b.begin(), b.end());
+    double widest = 0;
+    size_t i = 0, j = 0;
+    while (i < a.size() && j < b.size()) {
+        int x = std::min(a[i], b[j]);
+        while (i < a.size() && a[i] == x) i++;
+        while (j < b.size() && b[j] == x) j++;
+        widest = std::max(widest, std::abs((double)i / a.size() - (double)j / b.size()));
+    }
+    return widest;
+}
+
+/**
+ * Fits the fast engine to play-by-play games between random pairs of schools, then plays a held-out set of pairs with
+ * both engines and compares what comes out: the mean and spread of each total, and how far apart the distributions of
+ * points and margins are. Also prints the fitted lines, which is where FastSimModel::defaults() comes from.
+ */
+void benchFastSim(int fitGames, int validationGames, unsigned seed) {
+    printf("\n===== FAST SIM VALIDATION =====\n");
+    std::srand(seed);
+    RNG::gen.seed(seed);
+    League league;
+    const std::vector<School*>& schools = league.getAllSchools();
+
+    auto start = std::chrono::steady_clock::now();
+    const FastSimModel& model = league.calibrateFastSim(fitGames, seed);
+    double fitting = elapsedMs(start);
+    printf("Fit to %d play-by-play games in %.0f ms\n", fitGames, fitting);
+    for (int s = 0; s < NUM_FAST_STATS; s++) {
+        printf("  { %.4g, %.4f, %.3g }, // %s\n", model.lines[s].intercept, model.lines[s].slope, model.lines[s].stdev, FAST_STAT_NAMES[s]);
+    }
+
+    std::mt19937 rng(seed + 1);
+    std::uniform_int_distribution<int> pick(0, schools.size() - 1);
+    std::vector<std::pair<School*, School*>> pairs;
+    while ((int)pairs.size() < validationGames) {
+        School* away = schools[pick(rng)];
+        School* home = schools[pick(rng)];
+        if (away != home) pairs.emplace_back(away, home);
+    }
+
+    start = std::chrono::steady_clock::now();
+    std::vector<EngineSample> full = FastSimModel::sampleFullEngine(pairs, seed + 1);
+    double fullMs = elapsedMs(start);
+
+    std::vector<EngineSample> fast(pairs.size());
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < (int)pairs.size(); i++) {
+        GameResult result = FastGamePlayer(pairs[i].first, pairs[i].second, model).play();
+        fast[i].stats[0] = EngineSample::totals(*result.awayStats);
+        fast[i].stats[1] = EngineSample::totals(*result.homeStats);
+        fast[i].points[0] = result.awayStats->points;
+        fast[i].points[1] = result.homeStats->points;
+        delete result.awayStats;
+        delete result.homeStats;
+    }
+    double fastMs = elapsedMs(start);
+
+    auto summarize = [](const std::vector<int>& values) {
+        double mean = 0, squares = 0;
+        for (int v : values) mean += v;
+        mean /= values.size();
+        for (int v : values) squares += (v - mean) * (v - mean);
+        return std::make_pair(mean, std::sqrt(squares / values.size()));
+    };
+    auto compare = [&](const char* name, const std::vector<int>& a, const std::vector<int>& b) {
+        std::pair<double, double> f = summarize(a);
+        std::pair<double, double> q = summarize(b);
+        printf("%-15s %7.1f %7.1f   %7.1f %7.1f   %5.3f\n", name, f.first, f.second, q.first, q.second, ksStatistic(a, b));
+    };
+
+    printf("\nHeld out %d games. Play-by-play then fast, mean and sd, then the KS distance\n", validationGames);
+    for (int s = 0; s < NUM_FAST_STATS; s++) {
+        std::vector<int> a, b;
+        for (int i = 0; i < (int)pairs.size(); i++) {
+            for (int side = 0; side < 2; side++) {
+                a.push_back(full[i].stats[side][s]);
+                b.push_back(fast[i].stats[side][s]);
+            }
+        }
+        compare(FAST_STAT_NAMES[s], a, b);
+    }
+    std::vector<int> fullPoints, fastPoints, fullMargins, fastMargins;
+    int agreed = 0;
+    for (int i = 0; i < (int)pairs.size(); i++) {
+        fullPoints.insert(fullPoints.end(), { full[i].points[0], full[i].points[1] });
+        fastPoints.insert(fastPoints.end(), { fast[i].points[0], fast[i].points[1] });
+        fullMargins.push_back(full[i].points[0] - full[i].points[1]);
+        fastMargins.push_back(fast[i].points[0] - fast[i].points[1]);
+        agreed += (fullMargins.back() > 0) == (fastMargins.back() > 0);
+    }
+    compare("Points", fullPoints, fastPoints);
+    compare("Away margin", fullMargins, fastMargins);
+    printf("Same winner in %.1f%% of games\n", 100.0 * agreed / pairs.size());
+    printf("Play-by-play %.3f ms per game, fast %.4f ms per game (%.0fx)\n", fullMs / pairs.size(), fastMs / pairs.size(), fullMs / fastMs);
+}
@@ -0,0 +1,29 @@
+#include "benchCoaches.h"
+#include "benchFastSim.h"
+#include "benchMatchups.h"
+#include "benchPlayLog.h"
+#include "benchPlayoffOdds.h"
+#include "benchRankings.h"
+#include "benchRecruits.h"
+#include "benchWinProbabilities.h"
+#include "../src/loadData.h"
+
+#include <cstdlib>
+
+// Usage: cfbSimBench [iterations] [seed]
+int main(int argc, char** argv) {
+    int iterations = argc > 1 ? std::atoi(argv[1]) : 50;
+    unsigned seed = argc > 2 ? std::atoi(argv[2]) : 1;
+    GlobalData::loadEverything();
+
+    benchCoaches(iterations, seed);
+    benchRecruiting(std::max(1, iterations / 5), seed);
+    benchRankings(iterations, seed);
+    benchRankingAlgorithms(seed);
+    benchPlayoffOdds(iterations * 40, seed);
+    benchMatchups(iterations * 10, seed);
+    benchWinProbabilities(seed);
+    benchFastSim(iterations * 40, iterations * 10, seed);
+    benchPlayLog(iterations * 2, seed);
+    return 0;
+}
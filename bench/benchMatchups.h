@@ -0,0 +1,41 @@
+#pragma once
+#include "../src/league/league.h"
+
+// Replays week 1's first game the way simOneGameRepeatedly used to (serially, a fresh pair of snapshots and TeamStats per
+// game), through the matchup simulator, and through the lockstep engine ten times over. None of them apply their
+// injuries, so the real rosters should come out as they went in.
+void benchMatchups(int games, unsigned seed) {
+    printf("\n===== MATCHUP REPLAYS (%d games) =====\n", games);
+    std::srand(seed);
+    RNG::gen.seed(seed);
+    League league;
+    School* away = league.getAllSchools()[0]->getGameResults(0)->away;
+    School* home = league.getAllSchools()[0]->getGameResults(0)->home;
+    std::vector<int> awayInjuries = away->getRoster()->saveInjuries();
+    std::vector<int> homeInjuries = home->getRoster()->saveInjuries();
+
+    MatchupOdds odds = MatchupSimulator(away, home).run(games, 0, seed);
+    MatchupOdds lockstep = MatchupSimulator(away, home).runLockstep(games * 10, 0, seed);
+
+    auto start = std::chrono::steady_clock::now();
+    int awayWins = 0;
+    for (int i = 0; i < games; i++) {
+        GameResult result = GamePlayer(away, home).startRealTimeGameLoop(false);
+        if (result.awayWon) awayWins++;
+        delete result.awayStats;
+        delete result.homeStats;
+    }
+    double serial = elapsedMs(start);
+    bool untouched = away->getRoster()->saveInjuries() == awayInjuries && home->getRoster()->saveInjuries() == homeInjuries;
+
+    std::pair<double, double> ci = odds.awayWinInterval();
+    printf("Serial, fresh snapshots %7.0f games/sec, away won %.1f%%\n", games * 1000 / serial, 100.0 * awayWins / games);
+    printf("Matchup simulator       %8.0f games/sec, away won %.1f%% (%.1f-%.1f), rosters %s\n", odds.gamesPerSecond(),
+        100.0 * odds.awayWins / std::max(1, odds.awayWins + odds.homeWins), 100 * ci.first, 100 * ci.second,
+        untouched ? "untouched" : "CHANGED");
+    ci = lockstep.awayWinInterval();
+    printf("Lockstep (%d lanes)    %8.0f games/sec, away won %.1f%% (%.1f-%.1f)\n", LockstepGames::LANES, lockstep.gamesPerSecond(),
+        100.0 * lockstep.awayWins / std::max(1, lockstep.awayWins + lockstep.homeWins), 100 * ci.first, 100 * ci.second);
+    printf("Average score: %.1f - %.1f full engine, %.1f - %.1f lockstep\n", (double)odds.awayPoints / odds.games,
+        (double)odds.homePoints / odds.games, (double)lockstep.awayPoints / lockstep.games, (double)lockstep.homePoints / lockstep.games);
+}
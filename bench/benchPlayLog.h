@@ -0,0 +1,50 @@
+#pragma once
+#include "../src/league/league.h"
+
+// Plays a regular season, then writes its play log both ways and scans the mapped copy for every school's splits
+void benchPlayLog(int scans, unsigned seed) {
+    printf("\n===== PLAY LOG =====\n");
+    std::srand(seed);
+    RNG::gen.seed(seed);
+    League league;
+    for (int w = 0; w < 13; w++) league.simOneWeek();
+    const PlayLog& log = league.getPlayLog();
+    size_t rawBytes = log.numPlays() * sizeof(PlayRecord);
+    printf("%zu games, %zu snaps, %.2f MB of records\n", log.numGames(), log.numPlays(), rawBytes / 1e6);
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<uint8_t> packed = compressPlays(log.view().plays, log.numPlays());
+    double packing = elapsedMs(start);
+    std::vector<PlayRecord> unpacked(log.numPlays());
+    start = std::chrono::steady_clock::now();
+    bool ok = decompressPlays(packed.data(), packed.size(), unpacked.size(), unpacked.data());
+    double unpacking = elapsedMs(start);
+    ok = ok && std::memcmp(unpacked.data(), log.view().plays, rawBytes) == 0;
+    printf("Compressed to %.2f MB (%.1fx) in %.0f ms, back in %.0f ms, %s\n", packed.size() / 1e6, (double)rawBytes / packed.size(),
+        packing, unpacking, ok ? "intact" : "CORRUPTED");
+
+    std::string path = "benchPlayLog.bin";
+    MappedPlayLog mapped;
+    if (!log.save(path, false) || !mapped.open(path)) {
+        printf("Couldn't write and map %s\n", path.c_str());
+        return;
+    }
+    start = std::chrono::steady_clock::now();
+    std::vector<SituationalSplits> splits;
+    for (int i = 0; i < scans; i++) splits = situationalSplits(mapped.view());
+    double scanning = elapsedMs(start);
+    printf("Every school's splits from the mapped file: %.3f ms a season (%.2f GB/s)\n", scanning / scans,
+        rawBytes * (double)scans / scanning / 1e6);
+    std::remove(path.c_str());
+
+    SituationalSplits all;
+    for (const SituationalSplits& s : splits) {
+        all.drives += s.drives;
+        all.thirdDowns += s.thirdDowns;
+        all.thirdDownConversions += s.thirdDownConversions;
+        all.redZoneTrips += s.redZoneTrips;
+        all.redZoneTouchdowns += s.redZoneTouchdowns;
+    }
+    printf("League: %d drives, 3rd downs converted %.1f%%, red zone trips ending in a TD %.1f%%\n", all.drives, 100 * all.thirdDownRate(),
+        100 * all.redZoneTouchdownRate());
+}
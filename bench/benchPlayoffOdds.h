@@ -0,0 +1,66 @@
+#pragma once
+#include "../src/league/league.h"
+
+/**
+ * Fits the projector's margin model to fitGames play-by-play games between random pairs of schools in a fresh league: a
+ * straight line in the strength difference, whose intercept is home field. This is where PlayoffProjector::POINTS_PER_OVR
+ * and MARGIN_STDEV come from. Then projects the season from the halfway point, once out to the full 10,000 seasons, once
+ * stopping when the intervals are tight enough and once with lockstep margins for the games left, and checks the league
+ * hasn't moved.
+ */
+void benchPlayoffOdds(int fitGames, unsigned seed) {
+    printf("\n===== PLAYOFF ODDS FROM WEEK 7 =====\n");
+    std::srand(seed);
+    RNG::gen.seed(seed);
+    League league;
+    const std::vector<School*>& schools = league.getAllSchools();
+
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> pick(0, schools.size() - 1);
+    std::vector<std::pair<School*, School*>> pairs;
+    while ((int)pairs.size() < fitGames) {
+        School* away = schools[pick(rng)];
+        School* home = schools[pick(rng)];
+        if (away != home) pairs.emplace_back(away, home);
+    }
+    std::vector<EngineSample> samples = FastSimModel::sampleFullEngine(pairs, seed);
+    double n = pairs.size(), sx = 0, sy = 0, sxx = 0, sxy = 0;
+    for (int i = 0; i < (int)pairs.size(); i++) {
+        double x = PlayoffProjector::strengthOf(pairs[i].first) - PlayoffProjector::strengthOf(pairs[i].second);
+        double y = samples[i].points[0] - samples[i].points[1];
+        sx += x;
+        sy += y;
+        sxx += x * x;
+        sxy += x * y;
+    }
+    double slope = (n * sxy - sx * sy) / (n * sxx - sx * sx);
+    double intercept = (sy - slope * sx) / n;
+    double squares = 0;
+    for (int i = 0; i < (int)pairs.size(); i++) {
+        double x = PlayoffProjector::strengthOf(pairs[i].first) - PlayoffProjector::strengthOf(pairs[i].second);
+        double residual = samples[i].points[0] - samples[i].points[1] - intercept - slope * x;
+        squares += residual * residual;
+    }
+    printf("Margin fit to %d play-by-play games: %.3f points per OVR (projector uses %.2f), stdev %.1f (%.1f), home field %+.2f\n",
+        fitGames, slope, PlayoffProjector::POINTS_PER_OVR, std::sqrt(squares / n), PlayoffProjector::MARGIN_STDEV, -intercept);
+    for (int week = 0; week < 6; week++) league.simOneWeek();
+    School* first = league.getAllSchools()[0];
+    std::string before = first->getWinLossString() + " #" + std::to_string(first->getRanking());
+
+    auto start = std::chrono::steady_clock::now();
+    PlayoffOdds full = league.projectPlayoffOdds(10000, 0, seed);
+    double fullMs = elapsedMs(start);
+    start = std::chrono::steady_clock::now();
+    PlayoffOdds early = league.projectPlayoffOdds(10000, 0.02, seed);
+    double earlyMs = elapsedMs(start);
+    start = std::chrono::steady_clock::now();
+    PlayoffOdds lockstep = league.projectPlayoffOdds(10000, 0.02, seed, 64);
+    double lockstepMs = elapsedMs(start);
+
+    std::string after = first->getWinLossString() + " #" + std::to_string(first->getRanking());
+    full.print(10);
+    printf("Full run     %6d seasons %8.1f ms (%.1f us/season)\n", full.simulations, fullMs, fullMs * 1000 / full.simulations);
+    printf("Early stop   %6d seasons %8.1f ms (widest interval %.3f)\n", early.simulations, earlyMs, early.widestInterval());
+    printf("Lockstep     %6d seasons %8.1f ms (64 games a matchup for the margins)\n", lockstep.simulations, lockstepMs);
+    printf("League %s by the projection\n", before == after ? "untouched" : "CHANGED");
+}
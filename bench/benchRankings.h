@@ -0,0 +1,94 @@
+#pragma once
+#include "../src/league/league.h"
+
+// Offense and defense averages the way they used to be worked out inside the sort comparators: merging every regular
+// season box score from scratch
+std::pair<double, double> mergedAverageOffenseDefense(School* school) {
+    TeamStats ts;
+    for (int i = 0; i < 13; i++) {
+        School::Matchup* matchup = school->getGameResults(i);
+        if (matchup != nullptr) ts += *(school->getOrderedStats(matchup).first);
+    }
+    return std::make_pair(ts.offensiveYards() / (double)ts.games, ts.yardsAllowed / (double)ts.games);
+}
+
+// Plays a regular season, then times the week 13 offense/defense rankings both ways
+void benchRankings(int iterations, unsigned seed) {
+    printf("\n===== WEEK 13 RANKINGS (%d iterations) =====\n", iterations);
+    std::srand(seed);
+    RNG::gen.seed(seed);
+    League league;
+    for (int week = 0; week < 13; week++) league.simOneWeek();
+    std::vector<School*> schools = league.getAllSchools();
+
+    std::vector<School*> mergedOffense, mergedDefense;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) {
+        mergedOffense = schools;
+        std::sort(mergedOffense.begin(), mergedOffense.end(), [](School* a, School* b) {
+            return mergedAverageOffenseDefense(a).first > mergedAverageOffenseDefense(b).first;
+        });
+        mergedDefense = schools;
+        std::sort(mergedDefense.begin(), mergedDefense.end(), [](School* a, School* b) {
+            return mergedAverageOffenseDefense(a).second < mergedAverageOffenseDefense(b).second;
+        });
+    }
+    double merged = elapsedMs(start) / iterations;
+
+    SeasonTable table;
+    std::vector<int> byOffense, byDefense;
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) {
+        table.rebuild(schools);
+        std::vector<double> offense, defense;
+        for (int r = 0; r < table.size(); r++) {
+            offense.push_back(table[r].averageOffense);
+            defense.push_back(table[r].averageDefense);
+        }
+        byOffense = sortedOrder(offense, std::greater<double>());
+        byDefense = sortedOrder(defense, std::less<double>());
+    }
+    double tabled = elapsedMs(start) / iterations;
+
+    bool same = true;
+    for (int r = 0; r < table.size(); r++) {
+        same = same && table[byOffense[r]].school == mergedOffense[r] && table[byDefense[r]].school == mergedDefense[r];
+    }
+    printf("Merge in comparator %8.3f ms\n", merged);
+    printf("Season table        %8.3f ms  (%.1fx, %s order)\n", tabled, merged / tabled, same ? "same" : "DIFFERENT");
+}
+
+// Rates a played season week by week with each algorithm, once carrying the engine over from the week before and once
+// starting from scratch every week
+void benchRankingAlgorithms(unsigned seed) {
+    printf("\n===== WEEKLY RATINGS (13 weeks) =====\n");
+    std::srand(seed);
+    RNG::gen.seed(seed);
+    League league;
+    for (int week = 0; week < 13; week++) league.simOneWeek();
+    std::vector<School*> schools = league.getAllSchools();
+
+    std::pair<RankingAlgorithm, const char*> algorithms[] = { { RankingAlgorithm::ELO, "Elo" }, { RankingAlgorithm::MASSEY, "Massey" },
+        { RankingAlgorithm::COLLEY, "Colley" }, { RankingAlgorithm::BLENDED, "Blended" } };
+    for (auto [algorithm, label] : algorithms) {
+        RankingEngine warm;
+        warm.reset(schools);
+        double warmTotal = 0, coldTotal = 0;
+        int warmIterations = 0, coldIterations = 0;
+        for (int week = 1; week <= 13; week++) {
+            auto start = std::chrono::steady_clock::now();
+            warm.rate(algorithm, week);
+            warmTotal += elapsedMs(start);
+            warmIterations += warm.getLastIterations();
+
+            RankingEngine cold;
+            cold.reset(schools);
+            start = std::chrono::steady_clock::now();
+            cold.rate(algorithm, week);
+            coldTotal += elapsedMs(start);
+            coldIterations += cold.getLastIterations();
+        }
+        printf("%-8s warm %8.1f us/week (%5.1f CG iterations) | cold %8.1f us/week (%5.1f CG iterations)\n", label,
+            warmTotal * 1000 / 13, warmIterations / 13.0, coldTotal * 1000 / 13, coldIterations / 13.0);
+    }
+}
@@ -0,0 +1,43 @@
+#pragma once
+#include "../src/league/league.h"
+
+// Signs a number of recruiting classes into a freshly generated league, graduating a class in between
+void benchRecruitingClasses(RecruitingMode mode, const char* label, int classes, unsigned seed) {
+    std::srand(seed);
+    RNG::gen.seed(seed);
+    League league;
+    std::vector<School*> schools = league.getAllSchools();
+    auto rosterTotal = [&]() {
+        int total = 0;
+        for (School* school : schools) total += school->getRoster()->getRosterSize();
+        return total;
+    };
+
+    double generating = 0;
+    double total = 0;
+    int signedRecruits = 0;
+    long long searched = 0, scored = 0;
+    for (int c = 0; c < classes; c++) {
+        for (School* school : schools) school->advanceRosterOneYear();
+        RecruitLounge lounge;
+        lounge.setRecruitingMode(mode);
+        auto generateStart = std::chrono::steady_clock::now();
+        lounge.generateNewRecruitingClass();
+        generating += elapsedMs(generateStart);
+        int before = rosterTotal();
+        auto start = std::chrono::steady_clock::now();
+        lounge.signRecruitingClass(schools);
+        total += elapsedMs(start);
+        signedRecruits += rosterTotal() - before;
+        searched += lounge.getSchoolIndex().getSearchedCount();
+        scored += lounge.getSchoolIndex().getEvaluatedCount();
+    }
+    printf("%-18s per class %8.2f ms | generating %8.2f ms | signed per class %7.1f | scored %4.1f%% of pairs\n", label,
+        total / classes, generating / classes, (double)signedRecruits / classes, 100.0 * scored / std::max(searched, 1LL));
+}
+
+void benchRecruiting(int classes, unsigned seed) {
+    printf("\n===== RECRUITING (%d classes) =====\n", classes);
+    benchRecruitingClasses(RecruitingMode::GREEDY, "Greedy", classes, seed);
+    benchRecruitingClasses(RecruitingMode::STABLE_MATCHING, "Stable matching", classes, seed);
+}
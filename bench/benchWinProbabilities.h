@@ -0,0 +1,42 @@
+#pragma once
+#include "../src/league/league.h"
+
+// Fills the win-probability entries for ten of week 1's games, then times lookups and a lineup refresh, and counts how
+// many of the entries a played week leaves stale
+void benchWinProbabilities(unsigned seed) {
+    printf("\n===== WIN PROBABILITY MATRIX =====\n");
+    std::srand(seed);
+    RNG::gen.seed(seed);
+    League league;
+    WinProbabilityMatrix& matrix = league.getWinProbabilities();
+    std::vector<std::pair<School*, School*>> pairs;
+    for (School* school : league.getAllSchools()) {
+        School::Matchup* m = school->getGameResults(0);
+        if (m != nullptr && m->home == school && pairs.size() < 10) pairs.emplace_back(m->away, m->home);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    matrix.precompute(pairs);
+    double filled = elapsedMs(start);
+    int games = matrix.getGamesPlayed();
+
+    start = std::chrono::steady_clock::now();
+    double total = 0;
+    for (int i = 0; i < 1000; i++) {
+        for (auto& [away, home] : pairs) total += matrix.awayWinChance(away, home);
+    }
+    double lookup = elapsedMs(start) * 1000 / (1000.0 * pairs.size());
+
+    start = std::chrono::steady_clock::now();
+    matrix.refresh();
+    double refresh = elapsedMs(start);
+
+    league.simOneWeek(); // Refreshes the league's matrix
+    int stale = 0;
+    for (auto& [away, home] : pairs) stale += !matrix.isFresh(away, home);
+
+    printf("Filled %zu entries (%d games) in %.0f ms, so all 16,770 would take about %.0f s per core\n", pairs.size(), games,
+        filled, filled * 16770 / pairs.size() / 1000);
+    printf("Lookup %.3f us (mean chance %.3f), refresh %.3f ms\n", lookup, total / (1000.0 * pairs.size()), refresh);
+    printf("After week 1: %d of %zu entries stale\n", stale, pairs.size());
+}
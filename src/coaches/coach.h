@@ -54,6 +54,10 @@ CoachType getPositionalCoachType(Position p) {
 	}
 }
 
+// Coaches step away once they hit this age, or once they've been out of work for this many years
+const int COACH_RETIREMENT_AGE = 70;
+const int COACH_MAX_YEARS_UNEMPLOYED = 3;
+
 class School;
 struct Vacancy {
 	School* school = nullptr;
@@ -76,14 +80,19 @@ struct CoachingHistory {
 	bool fired;
 };
 
+class Coach;
+using CoachHandle = Handle<Coach>;
+
 class Coach {
+	CoachHandle handle;
 	std::string name;
 	int age;
 	std::string almaMater;
 	CoachType primaryType;
 	Vacancy currentJob;
 	std::vector<CoachingHistory> history;
-	int yearsInCurrentJob;
+	int yearsInCurrentJob = 0;
+	int yearsUnemployed = 0;
 	double priorityMoney;     // 0-1
 	double priorityStability; // 0-1
 	double priorityAlumni;    // 0-1
@@ -149,6 +158,8 @@ public:
 			ovrPublic = std::min(ovrPublic, 99);
 		}
 		primaryType = (CoachType)(std::rand() % 8);
+		// Initial coaches are spread across whole careers, new ones are just breaking into the profession
+		age = initial ? 30 + std::rand() % 35 : 26 + std::rand() % 15;
 
 		priorityAlumni = (std::rand() % 100) / 100.0;
 		priorityMoney = (std::rand() % 100) / 100.0;
@@ -170,7 +181,10 @@ public:
 	}
 	Coach(bool isInitial, CoachType type) : Coach(isInitial) { primaryType = type; }
 
+	CoachHandle getHandle() { return handle; }
+	void setHandle(CoachHandle h) { handle = h; }
 	std::string getName() { return name; }
+	int getAge() { return age; }
 	int getPublicOvr() { return ovrPublic; }
 	int getActualOvr() { return std::round((ovrDevelopment + ovrGametime + ovrRecruiting) / 3.0); }
 	int getOvrDevelopment() { return ovrDevelopment; }
@@ -179,6 +193,12 @@ public:
 	std::string getTypeString() { return coachTypeToString(currentJob.type); }
 	CoachType getJobType() { return currentJob.type; }
 	School* getEmployer() { return currentJob.school; }
+	const Vacancy& getCurrentJob() { return currentJob; }
+	int getYearsInCurrentJob() { return yearsInCurrentJob; }
+	std::string getAlmaMater() { return almaMater; }
+	int getYearsUnemployed() { return yearsUnemployed; }
+
+	bool wantsToRetire() { return age >= COACH_RETIREMENT_AGE || yearsUnemployed >= COACH_MAX_YEARS_UNEMPLOYED; }
 
 	// Assessment: 0-1 inclusive. This function moves the public OVR needle towards the assessment percentage.
 	void givePublicAssessment(double assessment) {
@@ -202,7 +222,7 @@ public:
 		ovrPublic = std::max(ovrPublic, 40);
 	}
 
-	double getPreferenceLevel(Vacancy v) {
+	double getPreferenceLevel(const Vacancy& v) {
 		double b = v.salary / 1000000; // expected to be somewhere from roughly 6-50 (more often 10-30) for HC jobs, 1.3-4.2 for positional jobs
 		b += (b * priorityPrestige * (v.prestige / 10));
 		if (v.school == currentJob.school) b += (b * priorityStability) / (yearsInCurrentJob + 1);
@@ -210,10 +230,13 @@ public:
 		return b;
 	}
 
-	// Todo: eliminate this function, it is redundant and worthless now
-	int pickJob(std::vector<Vacancy>& vacancies) {
-		int favorite = pickFavoriteJob(vacancies);
-		return favorite;
+	// Whether this coach's background qualifies them for the given job type
+	bool canFill(CoachType type) {
+		if (type == CoachType::HC) return true;
+		if (type == CoachType::OC)
+			return primaryType == CoachType::QB || primaryType == CoachType::RB || primaryType == CoachType::OL || primaryType == CoachType::WR;
+		if (type == CoachType::DC) return primaryType == CoachType::DL || primaryType == CoachType::DB || primaryType == CoachType::LB;
+		return type == primaryType;
 	}
 
 	int pickFavoriteJob(std::vector<Vacancy>& vacancies) {
@@ -221,15 +244,7 @@ public:
 		double highestPreference = isEmployed() ? getPreferenceLevel(currentJob) : -1000000;
 		int bestJob = -1;
 		for (int i = 0; i < (int)vacancies.size(); i++) {
-			if (vacancies[i].type != CoachType::HC) {
-				if (vacancies[i].type == CoachType::OC) {
-					if (primaryType != CoachType::QB && primaryType != CoachType::RB && primaryType != CoachType::OL && primaryType != CoachType::WR)
-						continue;
-				} else if (vacancies[i].type == CoachType::DC) {
-					if (primaryType != CoachType::DL && primaryType != CoachType::DB && primaryType != CoachType::LB) continue;
-				} else if (vacancies[i].type != primaryType)
-					continue;
-			}
+			if (!canFill(vacancies[i].type)) continue;
 			double p = getPreferenceLevel(vacancies[i]);
 			if (p > highestPreference) {
 				bestJob = i;
@@ -243,6 +258,7 @@ public:
 		assert(!isEmployed());
 		currentJob = v;
 		yearsInCurrentJob = 0;
+		yearsUnemployed = 0;
 	}
 
 	bool isEmployed() { return (currentJob.school != nullptr); }
@@ -271,6 +287,8 @@ public:
 			normalizePriorities();
 		}
 		if (isEmployed()) yearsInCurrentJob++;
+		else
+			yearsUnemployed++;
 		age++;
 	}
 
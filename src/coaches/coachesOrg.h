@@ -1,27 +1,41 @@
 #pragma once
 
 #include "coach.h"
+#include "hiringMatcher.h"
 #include "../school.h"
 
 struct SortByPublicOvr {
 	bool operator()(Coach* a, Coach* b) { return (a->getPublicOvr() > b->getPublicOvr()); }
 };
 
+// GREEDY lets the best available coach pick first and gives the school a chance to snipe someone better. STABLE_MATCHING runs
+// deferred acceptance over the whole market at once (see HiringMatcher).
+enum class HiringMode { GREEDY, STABLE_MATCHING };
+
 class CoachesOrganization {
-	std::vector<Coach*> coaches; // the realm of all coaches
+	HiringMode hiringMode = HiringMode::GREEDY;
+	SlotPool<Coach> pool;        // Where the coaches actually live. Retired coaches' slots get recycled.
+	std::vector<Coach*> coaches; // the realm of all active coaches
 
-public:
-	Coach* generateCoach(bool isInitial) {
-		Coach* c = new Coach(isInitial);
+	template<typename... Args>
+	Coach* addCoach(Args&&... args) {
+		CoachHandle h = pool.emplace(std::forward<Args>(args)...);
+		Coach* c = pool.get(h);
+		c->setHandle(h);
 		coaches.push_back(c);
 		return c;
 	}
 
-	Coach* generateCoach(CoachType type) {
-		Coach* c = new Coach(false, type);
-		coaches.push_back(c);
-		return c;
-	}
+public:
+	Coach* generateCoach(bool isInitial) { return addCoach(isInitial); }
+
+	Coach* generateCoach(CoachType type) { return addCoach(false, type); }
+
+	void setHiringMode(HiringMode mode) { hiringMode = mode; }
+	HiringMode getHiringMode() { return hiringMode; }
+
+	Coach* getCoach(CoachHandle h) { return pool.get(h); }
+	int getCoachCount() { return coaches.size(); }
 
 	void initializeAllCoaches() {
 		coaches.reserve(1600);
@@ -53,32 +67,73 @@ public:
 	}
 
 	void fillAllVacancies(std::vector<School*> allSchools) {
-		std::vector<Vacancy> vacancies = getAllVacancies(allSchools);
+		if (hiringMode == HiringMode::STABLE_MATCHING) fillAllVacanciesByMatching(allSchools);
+		else
+			fillAllVacanciesGreedily(allSchools);
+		// Staffs are set for the season now
+		for (School* school : allSchools) school->refreshCoachingEffects();
+	}
+
+	void fillAllVacanciesGreedily(std::vector<School*> allSchools) {
+		VacancyBoard board;
+		for (const Vacancy& v : getAllVacancies(allSchools)) board.add(v);
 		SortByPublicOvr sbpo;
 		std::sort(coaches.begin(), coaches.end(), sbpo);
 		for (int i = 0; i < (int)coaches.size(); i++) {
 			Coach* coach = coaches[i];
-			int jobTaken = coach->pickJob(vacancies);
+			int jobTaken = board.findFavorite(coach);
 			if (jobTaken == -1) continue;
 			// The school now has a chance to snipe someone better
-			std::vector<Coach*> snipeSet(coaches.begin() + i, (coaches.size() > i + 30) ? (coaches.begin() + i + 30) : (coaches.end()));
-			Coach* sniped = vacancies[jobTaken].school->snipeCoach(snipeSet, vacancies, jobTaken);
+			int windowSize = std::min(30, (int)coaches.size() - i);
+			Coach* sniped = board.get(jobTaken).school->snipeCoach(&coaches[i], windowSize, board, jobTaken);
 			if (sniped != coach) i--;
 			coach = sniped;
 
 			if (coach->isEmployed()) {
 				// lmao they took a better gig
-				Vacancy v = createVacancy(coach->getEmployer(), coach->getJobType());
-				vacancies.push_back(v);
+				board.add(createVacancy(coach->getEmployer(), coach->getJobType()));
+				coach->getEmployer()->loseCoach(coach->getJobType());
+				coach->resign();
+			}
+			Vacancy job = board.get(jobTaken);
+			board.fill(jobTaken);
+			coach->takeJob(job);
+			job.school->signCoach(coach, job.type);
+			if (board.empty()) break;
+		}
+		fillWithWalkons(board.getOpenVacancies());
+	}
+
+	void fillAllVacanciesByMatching(std::vector<School*> allSchools) {
+		HiringMatcher matcher;
+		for (const Vacancy& v : getAllVacancies(allSchools)) matcher.addSeat(v);
+		SortByPublicOvr sbpo;
+		std::sort(coaches.begin(), coaches.end(), sbpo);
+		for (Coach* coach : coaches) {
+			// Coaches in their first year stay put, same as in the greedy carousel
+			if (!coach->isEmployed()) matcher.addUnemployedCoach(coach);
+			else if (coach->getYearsInCurrentJob() > 0)
+				matcher.addSeat(createVacancy(coach->getEmployer(), coach->getJobType()), coach);
+		}
+		matcher.run();
+
+		std::vector<std::pair<Coach*, Vacancy>> moves = matcher.getMoves();
+		// Everyone leaves their old job before anyone signs, so that the jobs they left are free to be taken
+		for (auto& [coach, job] : moves) {
+			if (coach->isEmployed()) {
 				coach->getEmployer()->loseCoach(coach->getJobType());
 				coach->resign();
 			}
-			coach->takeJob(vacancies[jobTaken]);
-			vacancies[jobTaken].school->signCoach(coach, vacancies[jobTaken].type);
-			vacancies.erase(vacancies.begin() + jobTaken);
-			if (vacancies.empty()) break;
 		}
-		for (Vacancy v : vacancies) {
+		for (auto& [coach, job] : moves) {
+			coach->takeJob(job);
+			job.school->signCoach(coach, job.type);
+		}
+		fillWithWalkons(matcher.getOpenJobs());
+	}
+
+	void fillWithWalkons(const std::vector<Vacancy>& openJobs) {
+		for (const Vacancy& v : openJobs) {
 			// No coaches wanted these jobs. Create bare minimum coaches
 			Coach* walkon = generateCoach(v.type);
 			walkon->takeJob(createVacancy(v.school, v.type));
@@ -115,11 +170,22 @@ public:
 		}
 	}
 
-	void advanceYear() {
-		for (Coach* coach : coaches) coach->incrementYear();
+	// Coaches who are too old or have been out of work too long leave the profession, vacating their job if they had one
+	void retireCoaches() {
+		auto retired = std::stable_partition(coaches.begin(), coaches.end(), [](Coach* c) { return !c->wantsToRetire(); });
+		for (auto it = retired; it != coaches.end(); it++) {
+			Coach* coach = *it;
+			if (coach->isEmployed()) {
+				coach->getEmployer()->loseCoachToRetirement(coach->getJobType());
+				coach->resign();
+			}
+			pool.remove(coach->getHandle());
+		}
+		coaches.erase(retired, coaches.end());
 	}
 
-	~CoachesOrganization() {
-		for (auto c : coaches) delete c;
+	void advanceYear() {
+		for (Coach* coach : coaches) coach->incrementYear();
+		retireCoaches();
 	}
 };
\ No newline at end of file
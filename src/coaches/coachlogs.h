@@ -3,22 +3,23 @@
 
 // Should be a member of each School
 
-enum class HiringAction { HIRED, FIRED, EXTENDED, DEPARTED };
+enum class HiringAction { HIRED, FIRED, EXTENDED, DEPARTED, RETIRED };
 
 struct HiringHistory {
 	int year;
-	Coach* coach;
+	std::string coachName; // By name, since the coach may have retired and left the coach pool since
 	CoachType role;
 	HiringAction action;
 	int contractLength;
 
 	void print() {
-		std::cout << year << ": " << coach->getName() << " was ";
+		std::cout << year << ": " << coachName << " ";
 		switch (action) {
-		case HiringAction::HIRED: std::cout << "hired as " << coachTypeToString(role) << " on a " << contractLength << " year contract"; break;
-		case HiringAction::FIRED: std::cout << "fired as " << coachTypeToString(role); break;
-		case HiringAction::EXTENDED: std::cout << "extended for " << contractLength << " years as " << coachTypeToString(role); break;
-		case HiringAction::DEPARTED: std::cout << "hired away, opening up the " << coachTypeToString(role) << " position"; break;
+		case HiringAction::HIRED: std::cout << "was hired as " << coachTypeToString(role) << " on a " << contractLength << " year contract"; break;
+		case HiringAction::FIRED: std::cout << "was fired as " << coachTypeToString(role); break;
+		case HiringAction::EXTENDED: std::cout << "was extended for " << contractLength << " years as " << coachTypeToString(role); break;
+		case HiringAction::DEPARTED: std::cout << "was hired away, opening up the " << coachTypeToString(role) << " position"; break;
+		case HiringAction::RETIRED: std::cout << "retired as " << coachTypeToString(role); break;
 		}
 		std::cout << "\n";
 	}
@@ -42,22 +43,27 @@ public:
 	}
 
 	void recordHire(Coach* coach, CoachType role, int contractLength) {
-		HiringHistory h{ year, coach, role, HiringAction::HIRED, contractLength };
+		HiringHistory h{ year, coach->getName(), role, HiringAction::HIRED, contractLength };
 		incomingHistory.back().push_back(h);
 	}
 
 	void recordExtension(Coach* coach, CoachType role, int contractLength) {
-		HiringHistory h{ year, coach, role, HiringAction::EXTENDED, contractLength };
+		HiringHistory h{ year, coach->getName(), role, HiringAction::EXTENDED, contractLength };
 		incomingHistory.back().push_back(h);
 	}
 
 	void recordFire(Coach* coach, CoachType role) {
-		HiringHistory h{ year, coach, role, HiringAction::FIRED, -1 };
+		HiringHistory h{ year, coach->getName(), role, HiringAction::FIRED, -1 };
 		outgoingHistory.back().push_back(h);
 	}
 
 	void recordLoss(Coach* coach, CoachType role) {
-		HiringHistory h{ year, coach, role, HiringAction::DEPARTED, -1 };
+		HiringHistory h{ year, coach->getName(), role, HiringAction::DEPARTED, -1 };
+		outgoingHistory.back().push_back(h);
+	}
+
+	void recordRetirement(Coach* coach, CoachType role) {
+		HiringHistory h{ year, coach->getName(), role, HiringAction::RETIRED, -1 };
 		outgoingHistory.back().push_back(h);
 	}
 
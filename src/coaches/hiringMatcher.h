@@ -0,0 +1,290 @@
+#pragma once
+
+#include "../school.h"
+
+#include <limits>
+#include <queue>
+#include <unordered_map>
+
+/**
+ * Coach-proposing deferred acceptance over every seat in the carousel: the open jobs, plus the current jobs of coaches who
+ * are free to move. Coaches propose in order of Coach::getPreferenceLevel, never to anything they don't strictly prefer over
+ * the job they already have. Each seat holds on to its favorite proposer so far, ranked by the school's
+ * SortByAdjustedPublicOvr, except that a coach can always take back their own job. Nobody proposes to the same seat twice,
+ * so it always terminates, and the result doesn't depend on who proposes first.
+ *
+ * Like VacancyBoard, a coach ranks the jobs in a (type, prestige tier) bucket purely by salary, apart from the bonus jobs at
+ * their own school and alma mater. So every bucket is sorted once up front, and each coach walks a cursor down the buckets
+ * they qualify for, with their bonus jobs ranked separately.
+ *
+ * Most of the work in plain deferred acceptance is weaker coaches getting turned down by seat after seat. Every school's
+ * adjusted OVR for a coach falls between their public OVR and the midpoint of their public and actual OVR, so a seat whose
+ * holder's worst case beats a coach's best case is sure to turn them down, now and for the rest of the matching. Each
+ * bucket keeps a min-tree over its holders' worst cases, so a coach skips straight to the next seat that might take them
+ * in O(log V).
+ */
+class HiringMatcher {
+	static constexpr double NOBODY = -std::numeric_limits<double>::infinity();
+	static constexpr double UNTOUCHABLE = std::numeric_limits<double>::infinity();
+
+	struct Seat {
+		Vacancy job;
+		Coach* incumbent; // nullptr if the job is already open
+		Coach* holder = nullptr;
+		SortByAdjustedPublicOvr taste;
+		int bucket = -1;
+		int bucketPos = -1;
+	};
+
+	// Seats of one job type and prestige tier, best paying first
+	struct Bucket {
+		std::vector<int> seatIds;
+		std::vector<double> minBar; // Min-tree over the worst case adjusted OVR of each seat's holder
+		int leaves = 1;
+
+		void build() {
+			while (leaves < (int)seatIds.size()) leaves *= 2;
+			minBar.assign(2 * leaves, UNTOUCHABLE);
+			for (int i = 0; i < (int)seatIds.size(); i++) minBar[leaves + i] = NOBODY;
+			for (int i = leaves - 1; i > 0; i--) minBar[i] = std::min(minBar[2 * i], minBar[2 * i + 1]);
+		}
+
+		void update(int pos, double bar) {
+			int i = leaves + pos;
+			minBar[i] = bar;
+			for (i /= 2; i > 0; i /= 2) minBar[i] = std::min(minBar[2 * i], minBar[2 * i + 1]);
+		}
+
+		// First position at or after pos whose holder could lose to someone with this best case, or size() if there isn't one
+		int firstBeatable(int pos, double bestCase) {
+			if (pos >= (int)seatIds.size()) return seatIds.size();
+			int i = leaves + pos;
+			if (minBar[i] <= bestCase) return pos;
+			// Climb until there's a beatable seat somewhere to the right, then descend to the leftmost one
+			while (true) {
+				while (i % 2 == 1) {
+					i /= 2;
+					if (i == 0) return seatIds.size();
+				}
+				i++;
+				if (minBar[i] <= bestCase) break;
+			}
+			while (i < leaves) i = (minBar[2 * i] <= bestCase) ? 2 * i : 2 * i + 1;
+			return std::min(i - leaves, (int)seatIds.size());
+		}
+	};
+
+	struct Cursor {
+		int bucket;
+		int pos;
+	};
+
+	struct Suitor {
+		Coach* coach;
+		int ownSeat = -1;
+		double reservation = -1000000; // Anything below this isn't worth proposing to
+		double bestCase = 0;           // Highest adjusted OVR any school could see in them
+		std::vector<Cursor> cursors;
+		std::vector<int> bonusSeats; // Best first
+		int bonusPos = 0;
+	};
+
+	std::vector<Seat> seats;
+	std::vector<Suitor> suitors;
+	std::unordered_map<Coach*, int> suitorIndex;
+	std::vector<Bucket> buckets;
+	std::vector<int> bucketsByType[(int)CoachType::UN]; // [type][prestige tier] -> bucket, or -1
+	std::unordered_map<School*, std::vector<int>> bySchool;
+	std::unordered_map<std::string, std::vector<int>> bySchoolName;
+
+	static double worstCase(Coach* c) { return std::min<double>(c->getPublicOvr(), (c->getPublicOvr() + c->getActualOvr()) / 2.0); }
+	static double bestCase(Coach* c) { return std::max<double>(c->getPublicOvr(), (c->getPublicOvr() + c->getActualOvr()) / 2.0); }
+
+	bool isBonusSeat(const Suitor& s, int id) {
+		const Vacancy& job = seats[id].job;
+		return (s.coach->isEmployed() && job.school == s.coach->getEmployer()) || job.schoolName == s.coach->getAlmaMater();
+	}
+
+	void buildBuckets() {
+		for (int id = 0; id < (int)seats.size(); id++) {
+			std::vector<int>& tiers = bucketsByType[(int)seats[id].job.type];
+			int tier = seats[id].job.prestige / 10;
+			if ((int)tiers.size() <= tier) tiers.resize(tier + 1, -1);
+			if (tiers[tier] == -1) {
+				tiers[tier] = buckets.size();
+				buckets.emplace_back();
+			}
+			seats[id].bucket = tiers[tier];
+			buckets[tiers[tier]].seatIds.push_back(id);
+		}
+		for (Bucket& bucket : buckets) {
+			std::vector<int>& ids = bucket.seatIds;
+			std::sort(ids.begin(), ids.end(), [this](int x, int y) {
+				int xMillions = seats[x].job.salary / 1000000;
+				int yMillions = seats[y].job.salary / 1000000;
+				if (xMillions != yMillions) return xMillions > yMillions;
+				return x < y;
+			});
+			for (int pos = 0; pos < (int)ids.size(); pos++) seats[ids[pos]].bucketPos = pos;
+			bucket.build();
+		}
+	}
+
+	void initSuitor(Suitor& s) {
+		Coach* coach = s.coach;
+		// A little slack so that rounding in SortByAdjustedPublicOvr never makes us skip a seat we shouldn't
+		s.bestCase = bestCase(coach) + 1e-6;
+		for (int t = 0; t < (int)CoachType::UN; t++) {
+			if (!coach->canFill((CoachType)t)) continue;
+			for (int b : bucketsByType[t]) {
+				if (b != -1) s.cursors.push_back(Cursor{ b, 0 });
+			}
+		}
+		auto addBonus = [&](const std::vector<int>& ids) {
+			for (int id : ids) {
+				if (id != s.ownSeat && coach->canFill(seats[id].job.type)) s.bonusSeats.push_back(id);
+			}
+		};
+		if (coach->isEmployed()) {
+			auto it = bySchool.find(coach->getEmployer());
+			if (it != bySchool.end()) addBonus(it->second);
+		}
+		auto it = bySchoolName.find(coach->getAlmaMater());
+		if (it != bySchoolName.end()) addBonus(it->second);
+		std::sort(s.bonusSeats.begin(), s.bonusSeats.end());
+		s.bonusSeats.erase(std::unique(s.bonusSeats.begin(), s.bonusSeats.end()), s.bonusSeats.end());
+		std::stable_sort(s.bonusSeats.begin(), s.bonusSeats.end(),
+			[&](int a, int b) { return coach->getPreferenceLevel(seats[a].job) > coach->getPreferenceLevel(seats[b].job); });
+	}
+
+	// The best seat the coach hasn't tried yet that might take them, or -1 if none of them beat what they already have
+	int nextProposal(Suitor& s) {
+		int best = -1;
+		int bestCursor = -1; // -1 means it came from the bonus seats
+		double bestPreference = s.reservation;
+		auto consider = [&](int id, int cursor) {
+			double p = s.coach->getPreferenceLevel(seats[id].job);
+			if (p > bestPreference || (p == bestPreference && best != -1 && id < best)) {
+				best = id;
+				bestCursor = cursor;
+				bestPreference = p;
+			}
+		};
+		for (int c = 0; c < (int)s.cursors.size(); c++) {
+			Cursor& cursor = s.cursors[c];
+			Bucket& bucket = buckets[cursor.bucket];
+			while (true) {
+				cursor.pos = bucket.firstBeatable(cursor.pos, s.bestCase);
+				if (cursor.pos >= (int)bucket.seatIds.size()) break;
+				int id = bucket.seatIds[cursor.pos];
+				if (id != s.ownSeat && !isBonusSeat(s, id)) break;
+				cursor.pos++;
+			}
+			if (cursor.pos < (int)bucket.seatIds.size()) consider(bucket.seatIds[cursor.pos], c);
+		}
+		if (s.bonusPos < (int)s.bonusSeats.size()) consider(s.bonusSeats[s.bonusPos], -1);
+		if (best == -1) return -1;
+		if (bestCursor == -1) s.bonusPos++;
+		else
+			s.cursors[bestCursor].pos++;
+		return best;
+	}
+
+	void hold(int id, Coach* coach) {
+		Seat& seat = seats[id];
+		seat.holder = coach;
+		buckets[seat.bucket].update(seat.bucketPos, coach == seat.incumbent ? UNTOUCHABLE : worstCase(coach));
+	}
+
+	// Schools can't tell apart coaches with the same adjusted OVR, so fall back on the order they entered the market to keep
+	// the matching independent of who proposes first
+	bool prefers(Seat& seat, Coach* a, Coach* b) {
+		if (seat.taste(a, b)) return true;
+		return !seat.taste(b, a) && suitorIndex[a] < suitorIndex[b];
+	}
+
+	// Returns whoever got turned away, if anyone
+	Coach* propose(int id, Coach* coach) {
+		Seat& seat = seats[id];
+		if (seat.holder == nullptr) {
+			hold(id, coach);
+			return nullptr;
+		}
+		if (seat.holder == seat.incumbent) return coach;
+		if (coach == seat.incumbent || prefers(seat, coach, seat.holder)) {
+			Coach* displaced = seat.holder;
+			hold(id, coach);
+			return displaced;
+		}
+		return coach;
+	}
+
+public:
+	// incumbent is the coach currently in the job, if they're part of the market
+	void addSeat(const Vacancy& job, Coach* incumbent = nullptr) {
+		int id = seats.size();
+		seats.push_back(Seat{ job, incumbent, nullptr, job.school->getCoachingTaste() });
+		bySchool[job.school].push_back(id);
+		bySchoolName[job.schoolName].push_back(id);
+		if (incumbent != nullptr) {
+			Suitor s;
+			s.coach = incumbent;
+			s.ownSeat = id;
+			s.reservation = incumbent->getPreferenceLevel(incumbent->getCurrentJob());
+			suitorIndex[incumbent] = suitors.size();
+			suitors.push_back(s);
+		}
+	}
+
+	void addUnemployedCoach(Coach* coach) {
+		assert(!coach->isEmployed());
+		Suitor s;
+		s.coach = coach;
+		suitorIndex[coach] = suitors.size();
+		suitors.push_back(s);
+	}
+
+	void run() {
+		buildBuckets();
+		// The order doesn't change the outcome, but letting the strongest coaches go first means seats rarely change hands
+		auto weaker = [this](int a, int b) {
+			if (suitors[a].bestCase != suitors[b].bestCase) return suitors[a].bestCase < suitors[b].bestCase;
+			return a > b;
+		};
+		std::priority_queue<int, std::vector<int>, decltype(weaker)> unmatched(weaker);
+		for (int i = 0; i < (int)suitors.size(); i++) {
+			initSuitor(suitors[i]);
+			unmatched.push(i);
+		}
+		while (!unmatched.empty()) {
+			Suitor& s = suitors[unmatched.top()];
+			unmatched.pop();
+			int id = nextProposal(s);
+			if (id == -1) {
+				// Out of better options: go back to their own job, or stay unemployed
+				if (s.ownSeat == -1) continue;
+				id = s.ownSeat;
+			}
+			Coach* rejected = propose(id, s.coach);
+			if (rejected != nullptr) unmatched.push(suitorIndex[rejected]);
+		}
+	}
+
+	// Every coach who ends up somewhere new, along with their new job
+	std::vector<std::pair<Coach*, Vacancy>> getMoves() {
+		std::vector<std::pair<Coach*, Vacancy>> moves;
+		for (Seat& seat : seats) {
+			if (seat.holder != nullptr && seat.holder != seat.incumbent) moves.emplace_back(seat.holder, seat.job);
+		}
+		return moves;
+	}
+
+	// The jobs nobody ended up in
+	std::vector<Vacancy> getOpenJobs() {
+		std::vector<Vacancy> open;
+		for (Seat& seat : seats) {
+			if (seat.holder == nullptr) open.push_back(seat.job);
+		}
+		return open;
+	}
+};
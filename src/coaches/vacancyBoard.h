@@ -0,0 +1,109 @@
+#pragma once
+
+#include "coach.h"
+
+#include <queue>
+#include <unordered_map>
+
+/**
+ * Every open coaching job during the carousel, indexed so that a coach's favorite job can be found without scanning all
+ * of them.
+ *
+ * A coach's preference for a job only grows with its salary (in whole millions), apart from three bonuses: the prestige
+ * bonus, which only depends on prestige / 10; the stability bonus for their current school; and the alumni bonus for their
+ * alma mater. So each job type keeps one max-heap per prestige tier, ordered by salary and then by posting order. The top
+ * of each heap is the best job in that bucket. Jobs at a coach's own school and alma mater are looked up separately.
+ * Filled jobs are removed lazily when they surface at the top of a heap.
+ */
+class VacancyBoard {
+	struct HeapEntry {
+		int millions;
+		int id;
+
+		// Most money first, then whoever was posted first
+		bool operator<(const HeapEntry& other) const {
+			if (millions != other.millions) return millions < other.millions;
+			return id > other.id;
+		}
+	};
+	using Heap = std::priority_queue<HeapEntry>;
+
+	std::vector<Vacancy> vacancies; // Indexed by id, which is the posting order
+	std::vector<bool> open;
+	int numOpen = 0;
+	std::vector<Heap> heaps[(int)CoachType::UN]; // [type][prestige tier]
+	std::unordered_map<School*, std::vector<int>> bySchool;
+	std::unordered_map<std::string, std::vector<int>> bySchoolName;
+
+	int topOf(Heap& heap) {
+		while (!heap.empty() && !open[heap.top().id]) heap.pop();
+		return heap.empty() ? -1 : heap.top().id;
+	}
+
+public:
+	int add(const Vacancy& v) {
+		int id = vacancies.size();
+		vacancies.push_back(v);
+		open.push_back(true);
+		numOpen++;
+		std::vector<Heap>& tiers = heaps[(int)v.type];
+		int tier = v.prestige / 10;
+		if ((int)tiers.size() <= tier) tiers.resize(tier + 1);
+		tiers[tier].push(HeapEntry{ v.salary / 1000000, id });
+		bySchool[v.school].push_back(id);
+		bySchoolName[v.schoolName].push_back(id);
+		return id;
+	}
+
+	void fill(int id) {
+		assert(open[id]);
+		open[id] = false;
+		numOpen--;
+	}
+
+	const Vacancy& get(int id) const { return vacancies[id]; }
+	int size() const { return numOpen; }
+	bool empty() const { return numOpen == 0; }
+
+	// The jobs nobody took, in posting order
+	std::vector<Vacancy> getOpenVacancies() const {
+		std::vector<Vacancy> remaining;
+		for (int id = 0; id < (int)vacancies.size(); id++) {
+			if (open[id]) remaining.push_back(vacancies[id]);
+		}
+		return remaining;
+	}
+
+	/**
+	 * Returns the id of the job the coach would most like to take, or -1 if they'd rather stay put. Same answer as
+	 * Coach::pickFavoriteJob over the list of open jobs in posting order, including the tie-breaks.
+	 */
+	int findFavorite(Coach* coach) {
+		if (coach->isEmployed() && coach->getYearsInCurrentJob() == 0) return -1;
+		double highestPreference = coach->isEmployed() ? coach->getPreferenceLevel(coach->getCurrentJob()) : -1000000;
+		int bestJob = -1;
+		auto consider = [&](int id) {
+			if (id == -1 || !open[id] || !coach->canFill(vacancies[id].type)) return;
+			double p = coach->getPreferenceLevel(vacancies[id]);
+			if (p > highestPreference || (p == highestPreference && bestJob != -1 && id < bestJob)) {
+				bestJob = id;
+				highestPreference = p;
+			}
+		};
+		for (int t = 0; t < (int)CoachType::UN; t++) {
+			if (!coach->canFill((CoachType)t)) continue;
+			for (Heap& heap : heaps[t]) consider(topOf(heap));
+		}
+		if (coach->isEmployed()) {
+			auto it = bySchool.find(coach->getEmployer());
+			if (it != bySchool.end()) {
+				for (int id : it->second) consider(id);
+			}
+		}
+		auto it = bySchoolName.find(coach->getAlmaMater());
+		if (it != bySchoolName.end()) {
+			for (int id : it->second) consider(id);
+		}
+		return bestJob;
+	}
+};
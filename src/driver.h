@@ -38,7 +38,8 @@ struct Driver {
 	void mainMenu() {
 		std::cout << "\n===== " << league->getCurrentYear() << " WEEK " << league->getCurrentWeek() << " =====\n";
 		int choice = getMenuChoice(
-			{ "View conference standings", "View AP top 25", "View information by school", "View Coaches dashboard", "View most recent recruiting summary", "Advance the season" }, true);
+			{ "View conference standings", "View AP top 25", "View information by school", "View Coaches dashboard", "View most recent recruiting summary", "Advance the season",
+			  "Project playoff odds" }, true);
 		if (choice == 1) {
 			conferenceStandingsMenu();
 		} else if (choice == 2) {
@@ -53,6 +54,14 @@ struct Driver {
 			league->printRecruitingSummary();
 		} else if (choice == 6) {
 			simMenu();
+		} else if (choice == 7) {
+			if (league->getCurrentWeek() > 16) std::cout << "The season is over\n";
+			else {
+				auto start = std::chrono::steady_clock::now();
+				PlayoffOdds odds = league->projectPlayoffOdds();
+				odds.print();
+				printf("(%.0f ms)\n", elapsedMs(start));
+			}
 		} else {
 			std::cout << "Invalid choice\n";
 		}
@@ -68,7 +77,7 @@ struct Driver {
 			while ("donald trump" == "fascist" || true) {
 				std::cout << "\nOptions: \n  1) View " + schoolName + "'s roster\n  2) View " + schoolName + "'s depth chart\n  3) View " + schoolName + "'s schedule/results\n  4) View " +
 					schoolName + "'s season stats\n  5) View " + schoolName + "'s coaching staff\n  6) View " + schoolName +
-					"'s coaching history\n  7) Go back\n";
+					"'s coaching history\n  7) Watch one of " + schoolName + "'s games play by play\n  8) Go back\n";
 				std::cout << "Enter selection: ";
 				int choice = getInt();
 				if (choice == 1) {
@@ -125,6 +134,18 @@ struct Driver {
 					}
 				} else if (choice == 6) {
 					league->printSchoolCoachingHistory(schoolName);
+				} else if (choice == 7) {
+					if (league->getCurrentWeek() == 1) {
+						std::cout << "No games have been played yet this season.\n";
+						continue;
+					}
+					std::cout << "Enter week number: ";
+					choice = getInt();
+					while (choice < 1 || choice > league->getCurrentWeek() - 1) {
+						std::cout << "Week must be between 1 and " << league->getCurrentWeek() - 1 << ", try again: ";
+						choice = getInt();
+					}
+					league->printPlayByPlay(schoolName, choice - 1);
 				} else
 					break;
 			}
@@ -193,9 +214,11 @@ struct Driver {
 				} else if (choice == 2) {
 					std::cout << "How many times would you like to simulate this game: ";
 					int times = getInt();
-					if (byName) league->simOneGameRepeatedly(input, times);
+					std::cout << "Stop once the 95% interval on the win chance is narrower than how many percent (0 to play them all): ";
+					double width = getInt() / 100.0;
+					if (byName) league->simOneGameRepeatedly(input, times, width);
 					else
-						league->simOneGameRepeatedly(std::stoi(input), times);
+						league->simOneGameRepeatedly(std::stoi(input), times, width);
 				}
 			}
 		} else if (choice == 2) {
@@ -0,0 +1,270 @@
+#pragma once
+
+#include "gamePlayer.h"
+
+#include <array>
+
+// Which engine plays the league's games. FAST skips the plays and draws each team's box score totals straight from a
+// model fitted to the play-by-play engine, so it has no injuries and no play-by-play.
+enum class GameEngine { PLAY_BY_PLAY, FAST };
+
+// The starters the fast engine rates: 3 WR 1 TE on offense against a base 4-3 on defense
+constexpr Personnel FAST_SIM_OFFENSE = OFFENSIVE_PERSONNEL[3];
+constexpr Personnel FAST_SIM_DEFENSE = { 4, { { { DL, 4 }, { LB, 3 }, { CB, 2 }, { S, 2 } } } };
+
+// The starters on each side of the ball, boiled down to the units that face each other
+struct UnitRatings {
+    double passing;  // QB (counted twice), receivers and tight end
+    double rushing;  // Halfback and offensive line
+    double front;    // Defensive line and linebackers
+    double coverage; // Corners and safeties
+    double offense;
+    double defense;
+
+    // Starter OVRs less the same missing-bonus penalty the play-by-play engine takes off every rating
+    static UnitRatings of(Roster* roster) {
+        auto effective = [](Player* p) { return p->getOVR() - 15 * (1 - p->getGametimeBonus()); };
+        auto mean = [&](const std::vector<Player*>& players, int from, int to) {
+            double total = 0;
+            for (int i = from; i < to; i++) total += effective(players[i]);
+            return total / (to - from);
+        };
+        // Same order as the personnel: OL 5, QB, HB, TE, WR 3 and DL 4, LB 3, CB 2, S 2
+        std::vector<Player*> offense = roster->getElevenMen(FAST_SIM_OFFENSE);
+        std::vector<Player*> defense = roster->getElevenMen(FAST_SIM_DEFENSE);
+        UnitRatings r;
+        r.passing = (2 * effective(offense[5]) + mean(offense, 7, 11) * 4) / 6;
+        r.rushing = (effective(offense[6]) + mean(offense, 0, 5) * 5) / 6;
+        r.front = mean(defense, 0, 7);
+        r.coverage = mean(defense, 7, 11);
+        r.offense = mean(offense, 0, 11);
+        r.defense = mean(defense, 0, 11);
+        return r;
+    }
+};
+
+// One team's totals in a game, which is everything the fast engine draws
+enum FastStat { RUSHES, RUSHING_YARDS, RUSHING_TDS, PASS_ATTEMPTS, COMPLETIONS, PASSING_YARDS, PASSING_TDS, INTS_THROWN, FGS_MADE, FGS_MISSED, PUNTS, NUM_FAST_STATS };
+
+const char* FAST_STAT_NAMES[NUM_FAST_STATS] = { "Rushes", "Rushing yards", "Rushing TDs", "Pass attempts", "Completions", "Passing yards",
+    "Passing TDs", "INTs thrown", "FGs made", "FGs missed", "Punts" };
+
+// Both sides of one play-by-play game, as the fast engine sees it
+struct EngineSample {
+    UnitRatings ratings[2]; // Away, home
+    std::array<int, NUM_FAST_STATS> stats[2];
+    int points[2];
+
+    static std::array<int, NUM_FAST_STATS> totals(TeamStats& s) {
+        return { s.rushes(), s.rushingYards(), s.rushingTDs(), s.passAttempts(), s.completions(), s.passingYards(), s.passingTDs(),
+            s.INTsThrown(), s.FGsMade(), s.FGsMissed(), s.punts() };
+    }
+};
+
+/**
+ * Each stat is a straight line in how one of the team's units matches up against the other team's: the run game against
+ * the front, the pass game against the coverage, and the kicking game against the whole defense. Small counts like
+ * touchdowns are drawn from a Poisson around the line and everything else from a normal.
+ */
+struct FastSimModel {
+    struct Line {
+        double intercept;
+        double slope;
+        double stdev;
+    };
+    std::array<Line, NUM_FAST_STATS> lines;
+
+    static double matchup(FastStat stat, const UnitRatings& offense, const UnitRatings& defense) {
+        switch (stat) {
+        case RUSHES:
+        case RUSHING_YARDS:
+        case RUSHING_TDS: return offense.rushing - defense.front;
+        case PASS_ATTEMPTS:
+        case COMPLETIONS:
+        case PASSING_YARDS:
+        case PASSING_TDS:
+        case INTS_THROWN: return offense.passing - defense.coverage;
+        default: return offense.offense - defense.defense;
+        }
+    }
+
+    static bool isCount(FastStat stat) {
+        return stat == RUSHING_TDS || stat == PASSING_TDS || stat == INTS_THROWN || stat == FGS_MADE || stat == FGS_MISSED;
+    }
+
+    double expected(FastStat stat, const UnitRatings& offense, const UnitRatings& defense) const {
+        return lines[stat].intercept + lines[stat].slope * matchup(stat, offense, defense);
+    }
+
+    // Least squares for every stat over both sides of every game
+    static FastSimModel fit(const std::vector<EngineSample>& samples) {
+        FastSimModel model;
+        for (int s = 0; s < NUM_FAST_STATS; s++) {
+            double n = 0, sx = 0, sy = 0, sxx = 0, sxy = 0;
+            for (const EngineSample& sample : samples) {
+                for (int side = 0; side < 2; side++) {
+                    double x = matchup((FastStat)s, sample.ratings[side], sample.ratings[1 - side]);
+                    double y = sample.stats[side][s];
+                    n++;
+                    sx += x;
+                    sy += y;
+                    sxx += x * x;
+                    sxy += x * y;
+                }
+            }
+            Line& line = model.lines[s];
+            double spread = n * sxx - sx * sx;
+            line.slope = spread > 0 ? (n * sxy - sx * sy) / spread : 0;
+            line.intercept = (sy - line.slope * sx) / n;
+            double squares = 0;
+            for (const EngineSample& sample : samples) {
+                for (int side = 0; side < 2; side++) {
+                    double residual = sample.stats[side][s] - model.expected((FastStat)s, sample.ratings[side], sample.ratings[1 - side]);
+                    squares += residual * residual;
+                }
+            }
+            line.stdev = std::sqrt(squares / n);
+        }
+        return model;
+    }
+
+    /**
+     * Plays the given (away, home) pairs with the play-by-play engine on snapshots of their rosters, spread over every core.
+     * Each game seeds the RNG from seed and its index, and the calling thread's RNG is put back afterwards.
+     */
+    static std::vector<EngineSample> sampleFullEngine(const std::vector<std::pair<School*, School*>>& pairs, unsigned seed) {
+        std::vector<EngineSample> samples(pairs.size());
+        parallelFor(pairs.size(), [&](int i) {
+            std::mt19937 callersGen = RNG::gen;
+            std::seed_seq seeds{ seed, (unsigned)i };
+            RNG::gen.seed(seeds);
+            EngineSample& sample = samples[i];
+            sample.ratings[0] = UnitRatings::of(pairs[i].first->getRoster());
+            sample.ratings[1] = UnitRatings::of(pairs[i].second->getRoster());
+            TeamSnapshot awaySnapshot(pairs[i].first->getRoster());
+            TeamSnapshot homeSnapshot(pairs[i].second->getRoster());
+            TeamStats awayStats, homeStats;
+            GamePlayer game(pairs[i].first, pairs[i].second, &awaySnapshot, &homeSnapshot, &awayStats, &homeStats);
+            GameResult result = game.startRealTimeGameLoop(false);
+            sample.stats[0] = EngineSample::totals(*result.awayStats);
+            sample.stats[1] = EngineSample::totals(*result.homeStats);
+            sample.points[0] = result.awayStats->points;
+            sample.points[1] = result.homeStats->points;
+            RNG::gen = callersGen;
+        });
+        return samples;
+    }
+
+    // Fitted to 4,000 play-by-play games between random pairs of schools in a fresh league (seed 1, see benchFastSim)
+    static FastSimModel defaults() {
+        FastSimModel model;
+        model.lines = { {
+            { 25.61, 0.2197, 5.69 }, // Rushes
+            { 184.2, 3.1125, 64.8 }, // Rushing yards
+            { 1.541, 0.0496, 1.20 }, // Rushing TDs
+            { 33.32, 0.3428, 5.49 }, // Pass attempts
+            { 19.60, 0.2935, 4.65 }, // Completions
+            { 188.8, 2.5849, 74.7 }, // Passing yards
+            { 1.785, 0.0563, 1.31 }, // Passing TDs
+            { 0.983, -0.0045, 0.995 }, // INTs thrown
+            { 1.169, 0.0223, 1.03 }, // FGs made
+            { 0.450, 0.0058, 0.661 }, // FGs missed
+            { 6.650, -0.1425, 2.02 }, // Punts
+        } };
+        return model;
+    }
+};
+
+/**
+ * Plays a game without playing any plays: each team's totals are drawn from the model, points come from its touchdowns
+ * and field goals, and the totals are credited to the starters so the box score reads like a real one.
+ */
+class FastGamePlayer {
+    School* away;
+    School* home;
+    const FastSimModel& model;
+
+    std::array<int, NUM_FAST_STATS> drawTotals(const UnitRatings& offense, const UnitRatings& defense) {
+        std::array<int, NUM_FAST_STATS> totals;
+        for (int s = 0; s < NUM_FAST_STATS; s++) {
+            double mean = model.expected((FastStat)s, offense, defense);
+            if (FastSimModel::isCount((FastStat)s)) {
+                std::poisson_distribution<int> count(std::max(0.01, mean));
+                totals[s] = count(RNG::gen);
+            } else {
+                std::normal_distribution<double> amount(mean, model.lines[s].stdev);
+                totals[s] = (int)std::lround(amount(RNG::gen));
+            }
+        }
+        totals[RUSHES] = std::max(totals[RUSHES], 1);
+        totals[PASS_ATTEMPTS] = std::max(totals[PASS_ATTEMPTS], 1);
+        totals[COMPLETIONS] = std::max(0, std::min(totals[COMPLETIONS], totals[PASS_ATTEMPTS]));
+        totals[PUNTS] = std::max(totals[PUNTS], 0);
+        if (totals[COMPLETIONS] == 0) totals[PASSING_YARDS] = 0;
+        return totals;
+    }
+
+    static void recordTotals(TeamStats& offense, TeamStats& defense, Roster* roster, Roster* defenders, const std::array<int, NUM_FAST_STATS>& t) {
+        std::vector<Player*> starters = roster->getElevenMen(FAST_SIM_OFFENSE);
+        Player* quarterback = starters[5];
+        Player* halfback = starters[6];
+        // Tight end and the three receivers, who split the catches
+        Player* receivers[4] = { starters[8], starters[9], starters[10], starters[7] };
+        const int shares[4] = { 35, 25, 15, 25 };
+
+        offense.statsFor(halfback).rushes += t[RUSHES];
+        offense.statsFor(halfback).rushingYards += t[RUSHING_YARDS];
+        offense.statsFor(halfback).rushingTDs += t[RUSHING_TDS];
+
+        PlayerStats& qb = offense.statsFor(quarterback);
+        qb.completions += t[COMPLETIONS];
+        qb.incompletions += t[PASS_ATTEMPTS] - t[COMPLETIONS];
+        qb.passingYards += t[PASSING_YARDS];
+        qb.passingTDs += t[PASSING_TDS];
+        qb.INTsThrown += t[INTS_THROWN];
+        int caughtSoFar = 0, yardsSoFar = 0, touchdownsSoFar = 0;
+        for (int r = 0; r < 4; r++) {
+            PlayerStats& receiver = offense.statsFor(receivers[r]);
+            int catches = r == 3 ? t[COMPLETIONS] - caughtSoFar : t[COMPLETIONS] * shares[r] / 100;
+            int yards = r == 3 ? t[PASSING_YARDS] - yardsSoFar : t[PASSING_YARDS] * shares[r] / 100;
+            int touchdowns = r == 3 ? t[PASSING_TDS] - touchdownsSoFar : t[PASSING_TDS] * shares[r] / 100;
+            receiver.catches += catches;
+            receiver.receivingYards += yards;
+            receiver.receivingTDs += touchdowns;
+            caughtSoFar += catches;
+            yardsSoFar += yards;
+            touchdownsSoFar += touchdowns;
+        }
+
+        Player* kicker = roster->getElevenMen(OFFENSIVE_PERSONNEL[7])[5];
+        Player* punter = roster->getElevenMen(OFFENSIVE_PERSONNEL[8])[5];
+        offense.statsFor(kicker).FGsMade += t[FGS_MADE];
+        offense.statsFor(kicker).FGsMissed += t[FGS_MISSED];
+        offense.statsFor(punter).punts += t[PUNTS];
+        offense.statsFor(punter).puntYards += t[PUNTS] * 40;
+
+        defense.statsFor(defenders->getElevenMen(FAST_SIM_DEFENSE)[7]).INTsCaught += t[INTS_THROWN];
+
+        offense.points = 7 * (t[RUSHING_TDS] + t[PASSING_TDS]) + 3 * t[FGS_MADE];
+        offense.timeOfPossession = 30 * (t[RUSHES] + t[PASS_ATTEMPTS]);
+        defense.yardsAllowed = t[RUSHING_YARDS] + t[PASSING_YARDS];
+    }
+
+public:
+    FastGamePlayer(School* awaySchool, School* homeSchool, const FastSimModel& fastSimModel)
+        : away(awaySchool), home(homeSchool), model(fastSimModel) {}
+
+    // Same ownership as GamePlayer: the caller takes both TeamStats
+    GameResult play() {
+        TeamStats* awayStats = new TeamStats();
+        TeamStats* homeStats = new TeamStats();
+        awayStats->roster = away->getRoster();
+        homeStats->roster = home->getRoster();
+        UnitRatings awayRatings = UnitRatings::of(away->getRoster());
+        UnitRatings homeRatings = UnitRatings::of(home->getRoster());
+        recordTotals(*awayStats, *homeStats, away->getRoster(), home->getRoster(), drawTotals(awayRatings, homeRatings));
+        recordTotals(*homeStats, *awayStats, home->getRoster(), away->getRoster(), drawTotals(homeRatings, awayRatings));
+        bool homeWins = awayStats->points < homeStats->points;
+        return GameResult{ awayStats, homeStats, !homeWins, homeWins };
+    }
+};
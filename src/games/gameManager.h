@@ -39,14 +39,14 @@ class GameManager {
     void scoreOffensiveTD() {
         if (homePossession) homePoints += 7;
         else awayPoints += 7;
-        printPlay("TOUCHDOWN! " + scoreString());
+        if (printPlayByPlay) printPlay("TOUCHDOWN! " + scoreString());
         yardLine = 25;
         lineToGain = 15;
         flipPossession();
     }
 
 public:
-    bool printPlayByPlay;
+    bool printPlayByPlay = false; // Nothing gets put into words unless this is set
 
     GameManager() {
         clock = 900;
@@ -73,11 +73,13 @@ public:
     int getDown() { return down; }
     int getLineToGain() { return lineToGain; }
     int getYardsToGo() { return yardLine - lineToGain; }
+    int getQuarter() { return quarter; }
+    int getSecondsPlayed() { return (quarter - 1) * 900 + (900 - clock); }
 
     void scoreFieldGoal() {
         if (homePossession) homePoints += 3;
         else awayPoints += 3;
-        printPlay(scoreString());
+        if (printPlayByPlay) printPlay(scoreString());
         yardLine = 25;
         lineToGain = 15;
         flipPossession();
@@ -112,8 +114,10 @@ public:
             homePossession = !homePossession;
         }
         homeGetsNextPossession = !homeGetsNextPossession;
-        std::string name = homePossession ? home->getName() : away->getName();
-        printPlay("The " + name + " offense takes over at the " + yardLineAsStr() + ".");
+        if (printPlayByPlay) {
+            std::string name = homePossession ? home->getName() : away->getName();
+            printPlay("The " + name + " offense takes over at the " + yardLineAsStr() + ".");
+        }
     }
 
     /**
@@ -126,14 +130,17 @@ public:
         yardLine = std::abs(yardLine - 100);
         lineToGain = yardLine - 10;
         homePossession = !homePossession;
-        std::string name = homePossession ? home->getName() : away->getName();
-        printPlay("The " + name + " offense takes over at the " + yardLineAsStr() + ".");
+        if (printPlayByPlay) {
+            std::string name = homePossession ? home->getName() : away->getName();
+            printPlay("The " + name + " offense takes over at the " + yardLineAsStr() + ".");
+        }
     }
 
     /**
      * Prints the offense's current down, field position, and yards needed for a 1st down.
      */
     void printStatus() {
+        if (!printPlayByPlay) return;
         std::string suffix = down == 1 ? "st" : down == 2 ? "nd" : down == 3 ? "rd" : "th";
         int toGo = yardLine - lineToGain;
         std::string secondPart = lineToGain > 0 ? std::to_string(toGo) : "Goal";
@@ -164,9 +171,11 @@ public:
      * to convert on 4th down. Returns true if a touchdown is scored.
      */
     bool gainYards(int yards) {
-        if (yards == 0) printPlay("No gain on the play");
-        else
-            printPlay(std::to_string(std::abs(yards)) + " yard " + (yards < 0 ? "loss" : "gain") + " on the play");
+        if (printPlayByPlay) {
+            if (yards == 0) printPlay("No gain on the play");
+            else
+                printPlay(std::to_string(std::abs(yards)) + " yard " + (yards < 0 ? "loss" : "gain") + " on the play");
+        }
         yardLine -= yards;
         if (yardLine <= 0) {
             scoreOffensiveTD();
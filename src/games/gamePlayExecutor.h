@@ -25,6 +25,17 @@ enum IncompleteReason {
     PASS_INCOMPLETE_INTERCEPTED
 };
 
+// What a play looked like, in words. Only written when somebody's going to read it, so bulk sims never build a string.
+struct Narration {
+    bool enabled = false;
+    std::vector<std::string> lines;
+
+    template<class Describe>
+    void add(Describe describe) {
+        if (enabled) lines.push_back(describe());
+    }
+};
+
 struct PlayResult {
     PlayOutcome outcome;
     Player* carrier = nullptr;
@@ -33,7 +44,7 @@ struct PlayResult {
     Player* thrower = nullptr;
     IncompleteReason incompleteReason;
     bool specialTeamsPlay = false;
-    std::vector<std::string> messages;
+    Narration messages;
 };
 
 std::vector<Player*> getPlayersPerformingAction(std::vector<Player*>& players, Action action) {
@@ -58,11 +69,9 @@ double getCompositeRating(std::vector<Player*> players, Rating rating) {
 }
 
 class GamePlayExecutor {
-
-    static int rerollRunYards(double advantage) { return NumberMaker::getRunYardsGained(advantage); }
-    static int rerollPassYards(double advantage) { return NumberMaker::getPassYardsGained(); }
-
-    static bool engageTackler(Player* ballCarrier, Player* tackler, std::vector<std::string>& messages) {
+public:
+    // The ball carrier breaks the tackle if a roll of 0-99 comes up at or under this
+    static int breakTackleFactor(Player* ballCarrier, Player* tackler) {
         // Ball carrier does a speed break or strength break depending on tackler stats
         int speedDiff = ballCarrier->getRating(SPEED) - tackler->getRating(SPEED);
         int strenDiff = ballCarrier->getRating(STRENGTH) - tackler->getRating(STRENGTH);
@@ -75,34 +84,39 @@ class GamePlayExecutor {
             breakRating = (ballCarrier->getRating(STRENGTH) + ballCarrier->getRating(BREAKTACKLE)) / 2;
             tackleRating = (tackler->getRating(STRENGTH) + tackler->getRating(BREAKTACKLE)) / 2;
         }
-        int factor = std::round(0.2 * (breakRating - tackleRating)) + 35;
-        bool tackled = (std::rand() % 100) > factor;
+        return std::round(0.2 * (breakRating - tackleRating)) + 35;
+    }
+
+private:
+    static int rerollRunYards(double advantage) { return NumberMaker::getRunYardsGained(advantage); }
+    static int rerollPassYards(double advantage) { return NumberMaker::getPassYardsGained(); }
+
+    static bool engageTackler(Player* ballCarrier, Player* tackler, Narration& messages) {
+        bool tackled = RNG::randomNumberUniformDist(0, 99) > breakTackleFactor(ballCarrier, tackler);
         if (tackled) {
-            messages.push_back(ballCarrier->getPositionedName() + " tackled by " + tackler->getPositionedName());
+            messages.add([&] { return ballCarrier->getPositionedName() + " tackled by " + tackler->getPositionedName(); });
         } else {
-            messages.push_back(ballCarrier->getPositionedName() + " breaks a tackle by " + tackler->getPositionedName());
+            messages.add([&] { return ballCarrier->getPositionedName() + " breaks a tackle by " + tackler->getPositionedName(); });
         }
         return tackled;
     }
 
+    // Defenders take turns until one makes the tackle, and nobody gets a second try
     template<class Func>
-    static Player* runUntilTackled(Player* ballCarrier, std::vector<Player*> defenders, std::vector<double> defenderRatings,
-        int& yardsGained, Func rerollYards, double rerollAdvantage, std::vector<std::string>& messages) {
+    static Player* runUntilTackled(Player* ballCarrier, const std::vector<Player*>& defenders, const std::vector<double>& defenderRatings,
+        int& yardsGained, Func rerollYards, double rerollAdvantage, Narration& messages) {
         Player* tackler = nullptr;
-        std::vector<bool> failedTacklers(defenders.size(), false);
+        WeightedPicker tacklers(defenderRatings);
         do {
-            int tacklerIndex;
-            do {
-                tacklerIndex = RNG::randomWeightedIndex(defenderRatings);
-            } while (failedTacklers[tacklerIndex]);
+            int tacklerIndex = tacklers.draw();
             tackler = defenders[tacklerIndex];
 
             if (engageTackler(ballCarrier, tackler, messages)) break;
 
             int newYards = rerollYards(rerollAdvantage);
             if (newYards > yardsGained) yardsGained = newYards;
-            failedTacklers[tacklerIndex] = true;
-            if (std::find(failedTacklers.begin(), failedTacklers.end(), false) == failedTacklers.end()) {
+            tacklers.remove(tacklerIndex);
+            if (tacklers.size() == 0) {
                 yardsGained = 100;
                 break;
             }
@@ -111,35 +125,40 @@ class GamePlayExecutor {
         return tackler;
     }
 
-    static PlayResult doFieldGoalKick(Player* ballCarrier, int yardLine) {
+    static PlayResult doFieldGoalKick(Player* ballCarrier, int yardLine, bool narrate) {
         double accFactor = ballCarrier->getRating(KICKACCURACY) / 100.0;
         double powFactor = ballCarrier->getRating(KICKPOWER) / 100.0;
         PlayOutcome kickResult = (NumberMaker::didFieldGoalSucceed(yardLine, accFactor, powFactor)) ? FIELD_GOAL_SCORED : FIELD_GOAL_MISSED;
-        std::string kickString = (kickResult == FIELD_GOAL_SCORED) ? "The kick is good!" : "The kick is no good!";
+        Narration messages{ narrate };
+        messages.add([&] { return ballCarrier->getPositionedName() + " goes out for the field goal..."; });
+        messages.add([&] { return std::string(kickResult == FIELD_GOAL_SCORED ? "The kick is good!" : "The kick is no good!"); });
         return {
             outcome: kickResult,
             carrier : ballCarrier,
             yards : yardLine + 17,
             specialTeamsPlay : true,
-            messages : { ballCarrier->getPositionedName() + " goes out for the field goal...", kickString }
+            messages : messages
         };
     }
 
-    static PlayResult doPunt(Player* ballCarrier, int yardLine) {
+    static PlayResult doPunt(Player* ballCarrier, int yardLine, bool narrate) {
         int yds = std::round(0.4 * ballCarrier->getRating(PUNTPOWER)) + 15;
         yds += RNG::randomNumberNormalDist(0, 3);
         if (yds > yardLine) yds = yardLine;
+        Narration messages{ narrate };
+        messages.add([&] {
+            return ballCarrier->getPositionedName() + " punts the ball " + std::to_string(yds) + " yards" + (yardLine == 0 ? " for a touchback" : "");
+        });
         return {
             outcome: BALL_PUNTED,
             carrier : ballCarrier,
             yards : yds,
             specialTeamsPlay : true,
-            messages : { ballCarrier->getPositionedName() + " punts the ball " + std::to_string(yds) + " yards" +
-                (yardLine == 0 ? " for a touchback" : "") }
+            messages : messages
         };
     }
 
-    static PlayResult doRun(Field& field, Player* ballCarrier) {
+    static PlayResult doRun(Field& field, Player* ballCarrier, bool narrate) {
         double compBlockerRating = getCompositeRating(
             getPlayersPerformingAction(field.first, BLOCKING),
             RUNBLOCK
@@ -149,11 +168,11 @@ class GamePlayExecutor {
             RUNSTOP
         );
 
-        std::vector<std::string> messages;
+        Narration messages{ narrate };
         if (ballCarrier->getPosition() == QB)
-            messages.push_back(ballCarrier->getPositionedName() + " runs with the ball himself...");
+            messages.add([&] { return ballCarrier->getPositionedName() + " runs with the ball himself..."; });
         else
-            messages.push_back(ballCarrier->getPositionedName() + " takes the handoff...");
+            messages.add([&] { return ballCarrier->getPositionedName() + " takes the handoff..."; });
         std::vector<double> runStopRatings;
         for (auto& defender : field.second) runStopRatings.push_back(defender->getRating(RUNSTOP) + 70);
         double compositeDiff = (compBlockerRating / 9.0) - (compBlitzerRating / 11.0);
@@ -168,7 +187,7 @@ class GamePlayExecutor {
         };
     }
 
-    static PlayResult doPass(Field& field, Player* ballCarrier) {
+    static PlayResult doPass(Field& field, Player* ballCarrier, bool narrate) {
         double compBlockerRating = getCompositeRating(
             getPlayersPerformingAction(field.first, BLOCKING),
             PASSBLOCK
@@ -186,8 +205,8 @@ class GamePlayExecutor {
             PASSCOVER
         );
 
-        std::vector<std::string> messages;
-        messages.push_back(ballCarrier->getPositionedName() + " drops back to pass...");
+        Narration messages{ narrate };
+        messages.add([&] { return ballCarrier->getPositionedName() + " drops back to pass..."; });
         double olineStrength = RNG::randomNumberUniformDist(-15, 15) +
             (((compBlockerRating / 5.0) - (compBlitzerRating / 4.0)) * 0.1) + 45;
         double receivingAdvantage = ((compReceivingRating / 4.0) - (compCoverageRating / 7.0)) * 0.175;
@@ -207,7 +226,7 @@ class GamePlayExecutor {
                     rushRatings.push_back(blitzer->getRating(PASSRUSH));
                 }
                 Player* sacker = blitzers[RNG::randomWeightedIndex(rushRatings)];
-                messages.push_back(ballCarrier->getPositionedName() + " was sacked by " + sacker->getPositionedName());
+                messages.add([&] { return ballCarrier->getPositionedName() + " was sacked by " + sacker->getPositionedName(); });
 
                 return {
                     outcome: PASSER_SACKED,
@@ -239,7 +258,7 @@ class GamePlayExecutor {
                         double covererIndex = RNG::randomWeightedIndex(coverageRatings);
                         double intOdds = coverers[covererIndex]->getRating(CATCH);
                         if (RNG::randomNumberUniformDist(0, 400) < intOdds) {
-                            messages.push_back("Intercepted by " + coverers[covererIndex]->getPositionedName() + "!");
+                            messages.add([&] { return "Intercepted by " + coverers[covererIndex]->getPositionedName() + "!"; });
                             return {
                                 outcome: BALL_PASSED_INCOMPLETE,
                                 defender : coverers[covererIndex],
@@ -248,8 +267,8 @@ class GamePlayExecutor {
                                 messages : messages
                             };
                         }
-                        messages.push_back("Incomplete - intended for " + receiver->getPositionedName()
-                            + ". The throw was off-target.");
+                        messages.add([&] { return "Incomplete - intended for " + receiver->getPositionedName()
+                            + ". The throw was off-target."; });
                         return {
                             outcome: BALL_PASSED_INCOMPLETE,
                             thrower : ballCarrier,
@@ -266,7 +285,7 @@ class GamePlayExecutor {
                     double x = RNG::randomNumberUniformDist(0, 350);
                     if (x < intOdds) {
                         // Interception
-                        messages.push_back("Intercepted by " + coverer->getPositionedName() + "!");
+                        messages.add([&] { return "Intercepted by " + coverer->getPositionedName() + "!"; });
                         return {
                             outcome: BALL_PASSED_INCOMPLETE,
                             defender : coverer,
@@ -276,8 +295,8 @@ class GamePlayExecutor {
                         };
                     } else if (x < deflectOdds) {
                         // Pass deflection
-                        messages.push_back("Incomplete - intended for " + receiver->getPositionedName()
-                            + ". " + coverer->getPositionedName() + " deflected the ball.");
+                        messages.add([&] { return "Incomplete - intended for " + receiver->getPositionedName()
+                            + ". " + coverer->getPositionedName() + " deflected the ball."; });
                         return {
                             outcome: BALL_PASSED_INCOMPLETE,
                             defender : coverer,
@@ -290,8 +309,8 @@ class GamePlayExecutor {
                         double catchOdds = receiver->getRating(CATCH);
                         catchOdds = ((99 - catchOdds) / 2) + catchOdds;
                         if (RNG::randomNumberUniformDist(-150, 101) > catchOdds) {
-                            messages.push_back("Incomplete - intended for " + receiver->getPositionedName() +
-                                ". The receiver dropped the ball.");
+                            messages.add([&] { return "Incomplete - intended for " + receiver->getPositionedName() +
+                                ". The receiver dropped the ball."; });
                             return {
                                 outcome: BALL_PASSED_INCOMPLETE,
                                 carrier : receiver,
@@ -302,7 +321,7 @@ class GamePlayExecutor {
                         }
 
                         // Pass is caught - enter open-field tackle mode, starting with initial coverer
-                        messages.push_back("Completed pass to " + receiver->getPositionedName() + "!");
+                        messages.add([&] { return "Completed pass to " + receiver->getPositionedName() + "!"; });
                         Player* tackler = runUntilTackled(receiver, coverers, coverageRatings, passYards, rerollPassYards, 0, messages);
                         return {
                             outcome: BALL_PASSED_COMPLETE,
@@ -320,10 +339,10 @@ class GamePlayExecutor {
 public:
     /**
      * Takes an offensive play type and 22-player set, and simulates the play.
-     * Returns a PlayResult object to describe what happened.
+     * Returns a PlayResult object to describe what happened, in words too if narrate is set.
      */
-    static PlayResult executePlay(PlayType play, Field field, int yardLine) {
-        Player* ballCarrier;
+    static PlayResult executePlay(PlayType play, Field field, int yardLine, bool narrate = false) {
+        Player* ballCarrier = nullptr;
         for (auto offensivePlayer : field.first) {
             if (offensivePlayer->gameState.action == RUSHING || offensivePlayer->gameState.action == PASSING ||
                 offensivePlayer->gameState.action == KICKING) {
@@ -331,16 +350,17 @@ public:
                 break;
             }
         }
+        assert(ballCarrier != nullptr);
         if (play == KICK) {
-            return doFieldGoalKick(ballCarrier, yardLine);
+            return doFieldGoalKick(ballCarrier, yardLine, narrate);
         }
         if (play == PUNT) {
-            return doPunt(ballCarrier, yardLine);
+            return doPunt(ballCarrier, yardLine, narrate);
         }
         if (play == RUN) {
-            return doRun(field, ballCarrier);
+            return doRun(field, ballCarrier, narrate);
         } else {
-            return doPass(field, ballCarrier);
+            return doPass(field, ballCarrier, narrate);
         }
     }
 };
\ No newline at end of file
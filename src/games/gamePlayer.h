@@ -5,25 +5,62 @@
 #include "numberMaker.h"
 #include "gameManager.h"
 #include "gamePlayExecutor.h"
+#include "gameSnapshot.h"
+#include "playLog.h"
 
+#include <array>
+#include <cassert>
 #include <chrono>
 #include <iostream>
 #include <string>
 #include <thread>
 #include <functional>
+#include <memory>
 
-/**
- * Pure function that returns all players at a certain position from a given
- * subset of players.
- */
-std::vector<Player*> getPlayersAtPosition(const std::vector<Player*>& playerSet, Position pos) {
-	std::vector<Player*> players;
-	for (auto player : playerSet) {
-		if (player->getPosition() == pos) players.push_back(player);
+// This MUST MATCH UP with the order of the GamePlayer::OffensiveFormation enum!
+constexpr std::array<Personnel, 9> OFFENSIVE_PERSONNEL = { {
+	{ 5, { { { OL, 5 }, { QB, 1 }, { HB, 2 }, { TE, 2 }, { WR, 1 } } } }, // Goal line
+	{ 5, { { { OL, 5 }, { QB, 1 }, { HB, 1 }, { TE, 2 }, { WR, 2 } } } }, // TE2 WR2
+	{ 5, { { { OL, 5 }, { QB, 1 }, { HB, 2 }, { TE, 1 }, { WR, 2 } } } }, // Split backs
+	{ 5, { { { OL, 5 }, { QB, 1 }, { HB, 1 }, { TE, 1 }, { WR, 3 } } } }, // 3 WR 1 TE
+	{ 4, { { { OL, 5 }, { QB, 1 }, { HB, 1 }, { WR, 4 } } } }, // 4 WR
+	{ 4, { { { OL, 5 }, { QB, 1 }, { WR, 4 }, { TE, 1 } } } }, // Empty set 4WR
+	{ 3, { { { OL, 5 }, { QB, 1 }, { WR, 5 } } } }, // Empty set 5WR
+	{ 5, { { { OL, 5 }, { K, 1 }, { QB, 1 }, { TE, 2 }, { HB, 2 } } } }, // Field goal
+	{ 5, { { { OL, 5 }, { P, 1 }, { HB, 1 }, { TE, 2 }, { CB, 2 } } } } // Punt
+} };
+
+constexpr Personnel decideDefensivePersonnel(const Personnel& offense) {
+	Needs linebackerNeed{ LB, 0 };
+	Needs cornerbackNeed{ CB, 0 };
+	Needs safetyNeed{ S, 0 };
+	int spotsRemaining = 7; // 4 d-linemen at all times, 11 - 4 = 7
+	for (const Needs& offNeed : offense) {
+		if (offNeed.pos == WR) {
+			cornerbackNeed.num += offNeed.num;
+			spotsRemaining -= offNeed.num;
+		}
+		if (offNeed.pos == TE || offNeed.pos == HB) {
+			linebackerNeed.num += offNeed.num;
+			spotsRemaining -= offNeed.num;
+		}
 	}
-	return players;
+	while (spotsRemaining > 0 && safetyNeed.num < 2) {
+		safetyNeed.num++;
+		spotsRemaining--;
+	}
+	linebackerNeed.num += spotsRemaining;
+
+	return { 4, { { { DL, 4 }, linebackerNeed, cornerbackNeed, safetyNeed } } };
 }
 
+// The defense's answer to each offensive formation, worked out at compile time
+constexpr std::array<Personnel, 9> DEFENSIVE_PERSONNEL = [] {
+	std::array<Personnel, 9> packages{};
+	for (int i = 0; i < (int)packages.size(); i++) packages[i] = decideDefensivePersonnel(OFFENSIVE_PERSONNEL[i]);
+	return packages;
+}();
+
 class GamePlayer {
 private:
 	GameManager gameState;
@@ -31,37 +68,23 @@ private:
 	School* home;
 	TeamStats* offStats;
 	TeamStats* defStats;
-	Roster* offense;
-	Roster* defense;
+	TeamSnapshot* offense;
+	TeamSnapshot* defense;
+	TeamSnapshot* awayTeam;
+	TeamSnapshot* homeTeam;
+	std::unique_ptr<TeamSnapshot> ownedAway; // Only when the game took its own snapshots of the schools' rosters
+	std::unique_ptr<TeamSnapshot> ownedHome;
 	bool homePossession = false;
 
 	bool printPlayByPlay = false;
 
+	std::vector<PlayRecord>* playLog = nullptr; // Every snap gets appended here, if set
+	int lastOffense = -1; // Whose ball it was on the last logged snap (1 for home)
+	int lastQuarter = 1;
+
 	// Assume one back unless otherwise stated or implied
 	enum OffensiveFormation { GOALLINE, TE2, HB2, WR3, WR4, WR4_EMPTY, WR5, FGFORM, PUNTFORM };
 
-	// This MUST MATCH UP with the order of the OffensiveFormation enum!
-	const std::vector<std::vector<Needs>> OffensivePersonnel{
-		{ // Goal line
-		  Needs { OL, 5 }, Needs { QB, 1 }, Needs { HB, 2 }, Needs { TE, 2 }, Needs { WR, 1 } },
-		{ // TE2 WR2
-		  Needs { OL, 5 }, Needs { QB, 1 }, Needs { HB, 1 }, Needs { TE, 2 }, Needs { WR, 2 } },
-		{ // Split backs
-		  Needs { OL, 5 }, Needs { QB, 1 }, Needs { HB, 2 }, Needs { TE, 1 }, Needs { WR, 2 } },
-		{ // 3 WR 1 TE
-		  Needs { OL, 5 }, Needs { QB, 1 }, Needs { HB, 1 }, Needs { TE, 1 }, Needs { WR, 3 } },
-		{ // 4 WR
-		  Needs { OL, 5 }, Needs { QB, 1 }, Needs { HB, 1 }, Needs { WR, 4 } },
-		{ // Empty set 4WR
-		  Needs { OL, 5 }, Needs { QB, 1 }, Needs { WR, 4 }, Needs { TE, 1 } },
-		{ // Empty set 5WR
-		  Needs { OL, 5 }, Needs { QB, 1 }, Needs { WR, 5 } },
-		{ // Field goal
-		  Needs { OL, 5 }, Needs { K, 1 }, Needs { QB, 1 }, Needs { TE, 2 }, Needs { HB, 2 } },
-		{ // Punt
-		  Needs { OL, 5 }, Needs { P, 1 }, Needs { HB, 1 }, Needs { TE, 2 }, Needs { CB, 2 } }
-	};
-
 	void printPlay(std::string msg) {
 		if (printPlayByPlay) gameState.printPlay(msg);
 	}
@@ -73,17 +96,17 @@ private:
 		int down = gameState.getDown();
 		int yardLine = gameState.getYardLine();
 		int yardsToGo = gameState.getYardsToGo();
-		if (down == 3 && yardsToGo > 5) return (std::rand() % 100 < 90 ? PASS : RUN);
+		if (down == 3 && yardsToGo > 5) return (RNG::randomNumberUniformDist(0, 99) < 90 ? PASS : RUN);
 		if (down == 4) {
 			int fgDistance = yardLine + 17;
 			if (fgDistance > 50) {
 				if (yardLine > 40 || yardsToGo > 5) return PUNT;
-				return (std::rand() & 100 < 70 ? PASS : RUN);
+				return (RNG::randomNumberUniformDist(0, 99) < 70 ? PASS : RUN);
 			} else
 				return KICK;
 		}
-		if (yardsToGo < 4) return (std::rand() % 100 < 30 ? PASS : RUN);
-		return (std::rand() % 100 < 60) ? PASS : RUN;
+		if (yardsToGo < 4) return (RNG::randomNumberUniformDist(0, 99) < 30 ? PASS : RUN);
+		return (RNG::randomNumberUniformDist(0, 99) < 60) ? PASS : RUN;
 	}
 
 	/**
@@ -110,79 +133,64 @@ private:
 		return WR3;
 	}
 
-	std::vector<Needs> decideDefensivePersonnel(OffensiveFormation form) {
-		Needs linebackerNeed{ LB, 0 };
-		Needs cornerbackNeed{ CB, 0 };
-		Needs safetyNeed{ S, 0 };
-		int spotsRemaining = 7; // 4 d-linemen at all times, 11 - 4 = 7
-		for (auto offNeed : OffensivePersonnel[form]) {
-			if (offNeed.pos == WR) {
-				cornerbackNeed.num += offNeed.num;
-				spotsRemaining -= offNeed.num;
-			}
-			if (offNeed.pos == TE || offNeed.pos == HB) {
-				linebackerNeed.num += offNeed.num;
-				spotsRemaining -= offNeed.num;
-			}
-		}
-		while (spotsRemaining > 0 && safetyNeed.num < 2) {
-			safetyNeed.num++;
-			spotsRemaining--;
-		}
-		linebackerNeed.num += spotsRemaining;
-
-		return { { DL, 4 }, linebackerNeed, cornerbackNeed, safetyNeed };
-	}
-
 	/**
 	 * Mutates the game state of all 22 players on the field to assign them an action
 	 * based on the play type.
 	 */
 	Field applyFormation(OffensiveFormation form, PlayType play) {
-		std::vector<Player*> offOnField = offense->getElevenMen(OffensivePersonnel[form]);
-		std::vector<Player*> defOnField = defense->getElevenMen(decideDefensivePersonnel(form));
+		const Personnel& offPersonnel = OFFENSIVE_PERSONNEL[form];
+		std::vector<Player*> offOnField = offense->getElevenMen(offPersonnel);
+		std::vector<Player*> defOnField = defense->getElevenMen(DEFENSIVE_PERSONNEL[form]);
 
-		for (int i = 0; i < 11; ++i) {
-			Position offPos = offOnField[i]->getPosition();
-			offOnField[i]->gameState.action = BLOCKING; // as a default
+		// Assignments come from the role being filled, which isn't always the player's natural position (e.g. injuries)
+		Player* quarterback = nullptr;
+		std::vector<Player*> halfbacks;
+		int i = 0;
+		for (const Needs& role : offPersonnel) {
+			for (int n = 0; n < role.num; ++n, ++i) {
+				Player* player = offOnField[i];
+				Position offPos = role.pos;
+				player->gameState.action = BLOCKING; // as a default
 
-			if (offPos == OL) {
-				offOnField[i]->gameState.action = BLOCKING;
-			}
-			if (offPos == QB) {
-				offOnField[i]->gameState.action = (play == PASS) ? PASSING : HANDINGOFF;
-			}
-			if (offPos == HB) {
-				const Action a[2] = { BLOCKING, RECEIVING };
-				offOnField[i]->gameState.action =
-					(play == RUN) ? BLOCKING : a[RNG::randomWeightedIndex(std::vector<double> { 4, 5 })];
-			}
-			if (offPos == K || offPos == P) {
-				offOnField[i]->gameState.action = KICKING;
-			}
-			if (offPos == TE) {
-				if (play == PASS) {
+				if (offPos == OL) {
+					player->gameState.action = BLOCKING;
+				}
+				if (offPos == QB) {
+					player->gameState.action = (play == PASS) ? PASSING : HANDINGOFF;
+					quarterback = player;
+				}
+				if (offPos == HB) {
 					const Action a[2] = { BLOCKING, RECEIVING };
-					offOnField[i]->gameState.action = a[RNG::randomWeightedIndex(std::vector<double> { 2, 5 })];
-				} else {
-					offOnField[i]->gameState.action = BLOCKING;
+					player->gameState.action =
+						(play == RUN) ? BLOCKING : a[RNG::randomWeightedIndex(std::vector<double> { 4, 5 })];
+					halfbacks.push_back(player);
+				}
+				if (offPos == K || offPos == P) {
+					player->gameState.action = KICKING;
+				}
+				if (offPos == TE) {
+					if (play == PASS) {
+						const Action a[2] = { BLOCKING, RECEIVING };
+						player->gameState.action = a[RNG::randomWeightedIndex(std::vector<double> { 2, 5 })];
+					} else {
+						player->gameState.action = BLOCKING;
+					}
+				}
+				if (offPos == WR) {
+					player->gameState.action = (play == PASS) ? RECEIVING : BLOCKING;
 				}
-			}
-			if (offPos == WR) {
-				offOnField[i]->gameState.action = (play == PASS) ? RECEIVING : BLOCKING;
 			}
 		}
 
-		// If play is a pass, assign a runner
+		// If play is a run, assign a runner
 		if (play == RUN) {
-			std::vector<Player*> halfbacks = getPlayersAtPosition(offOnField, HB);
-			Player* quarterback = getPlayersAtPosition(offOnField, QB)[0]; // if this is out of bounds, something's wrong
+			assert(quarterback != nullptr); // Every non-special teams formation has a QB
 			if (halfbacks.size() == 0) {
 				quarterback->gameState.action = RUSHING;
 			} else {
 				// TODO: decide whether or not to run QB based on QB's running ability
-				if (std::rand() % 100 < 15) quarterback->gameState.action = RUSHING;
-				else (*select_randomly(halfbacks.begin(), halfbacks.end()))->gameState.action = RUSHING;
+				if (RNG::randomNumberUniformDist(0, 99) < 15) quarterback->gameState.action = RUSHING;
+				else (*select_randomly(halfbacks.begin(), halfbacks.end(), RNG::gen))->gameState.action = RUSHING;
 			}
 		}
 
@@ -218,6 +226,32 @@ private:
 		}
 	}
 
+	// Called before the result reaches the game state, so the situation is the one the play was called in
+	void logSnap(PlayType play, OffensiveFormation form, const PlayResult& result) {
+		bool halftime = gameState.getQuarter() == 3 && lastQuarter == 2;
+		lastQuarter = gameState.getQuarter();
+		auto slot = [](Player* p) { return p == nullptr ? PlayRecord::NOBODY : (uint16_t)p->getHandle().slot; };
+		int yardLine = gameState.getYardLine();
+		int gain = result.specialTeamsPlay ? result.yards : std::min(result.yards, yardLine);
+		PlayRecord record;
+		record.clock = gameState.getSecondsPlayed();
+		record.carrier = slot(result.carrier);
+		record.defender = slot(result.defender);
+		record.down = gameState.getDown();
+		record.yardsToGo = std::min(gameState.getYardsToGo(), 255);
+		record.yardLine = std::min(yardLine, 255);
+		record.play = play;
+		record.formation = form;
+		record.homeOffense = gameState.homeHasPossession(); // Can be ahead of homePossession on the snap after halftime
+		record.outcome = result.outcome;
+		record.incomplete = result.outcome == BALL_PASSED_INCOMPLETE ? result.incompleteReason : PASS_COMPLETED;
+		record.touchdown = !result.specialTeamsPlay && gain >= yardLine;
+		record.driveStart = halftime || record.homeOffense != lastOffense;
+		record.yards = std::max(-128, std::min(127, gain));
+		playLog->push_back(record);
+		lastOffense = record.homeOffense;
+	}
+
 	void runInjuryRisks(Field& field, PlayResult result) {
 		bool touchdown = (result.yards >= gameState.getYardLine());
 		const std::vector<std::vector<Player*>> sides = { field.first, field.second };
@@ -255,7 +289,7 @@ private:
 	}
 
 	void recordPlayResult(PlayResult result) {
-		for (auto& str : result.messages) printPlay(str);
+		for (auto& str : result.messages.lines) printPlay(str);
 		if (result.yards > gameState.getYardLine()) result.yards = gameState.getYardLine();
 		int gain = result.yards;
 		bool touchdown = (gain >= gameState.getYardLine());
@@ -292,7 +326,8 @@ private:
 		PlayType play = decidePlay();
 		OffensiveFormation form = decideFormation(play);
 		Field field = applyFormation(form, play);
-		PlayResult result = GamePlayExecutor::executePlay(play, field, gameState.getYardLine());
+		PlayResult result = GamePlayExecutor::executePlay(play, field, gameState.getYardLine(), printPlayByPlay);
+		if (playLog != nullptr) logSnap(play, form, result);
 		recordPlayResult(result);
 		runInjuryRisks(field, result);
 		updateGameState(result);
@@ -312,20 +347,47 @@ private:
 	}
 
 public:
-	GamePlayer(School* awaySchool, School* homeSchool) : away{ awaySchool }, home{ homeSchool } {
-		offense = awaySchool->getRoster();
-		defense = homeSchool->getRoster();
-		offStats = new TeamStats();
-		defStats = new TeamStats();
+	// Snapshots both schools' rosters as they are now. The real players are left alone: the game's injuries come back in
+	// the result, for the caller to apply if the game counts.
+	GamePlayer(School* awaySchool, School* homeSchool)
+		: GamePlayer(awaySchool, homeSchool, new TeamSnapshot(awaySchool->getRoster()), new TeamSnapshot(homeSchool->getRoster()),
+			new TeamStats(), new TeamStats()) {
+		ownedAway.reset(awayTeam);
+		ownedHome.reset(homeTeam);
+	}
+
+	// Plays on snapshots and records into stats, all of which the caller owns
+	GamePlayer(School* awaySchool, School* homeSchool, TeamSnapshot* awaySnapshot, TeamSnapshot* homeSnapshot, TeamStats* awayStats,
+		TeamStats* homeStats)
+		: away{ awaySchool }, home{ homeSchool } {
+		awayTeam = offense = awaySnapshot;
+		homeTeam = defense = homeSnapshot;
+		offStats = awayStats;
+		defStats = homeStats;
+		offStats->roster = offense->getSource();
+		defStats->roster = defense->getSource();
 		gameState.setCompetingSchools(homeSchool, awaySchool);
 	}
 
+	// Packs every snap of the game into log as it's played
+	void logPlaysTo(std::vector<PlayRecord>* log) { playLog = log; }
+
+	// Plays with RNG::gen seeded from seed, and puts the caller's generator back after. The same seed on rosters in the same
+	// state always plays out the same game, so a game can be told again later with play-by-play.
+	GameResult startSeededGameLoop(unsigned seed, bool playByPlay) {
+		std::mt19937 callersGen = RNG::gen;
+		RNG::gen.seed(seed);
+		GameResult result = startRealTimeGameLoop(playByPlay);
+		RNG::gen = callersGen;
+		return result;
+	}
+
 	GameResult startRealTimeGameLoop(bool playByPlay) {
 		printPlayByPlay = playByPlay;
 		gameState.printPlayByPlay = playByPlay;
 		if (playByPlay)
 			std::cout << "========== " << str_upper(away->getRankedName()) << " vs. " << str_upper(home->getRankedName()) << " ==========\n\n";
-		printPlay(away->getName() + " to start with the ball");
+		if (playByPlay) printPlay(away->getName() + " to start with the ball");
 		gameLoop();
 		if (homePossession) std::swap(offStats, defStats);
 		offStats->points = gameState.getAwayScore();
@@ -334,6 +396,6 @@ public:
 		if (playByPlay)
 			std::cout << "GAME OVER! Final score is " << away->getName() << ": " << gameState.getAwayScore() << ", " << home->getName() << ": " <<
 			gameState.getHomeScore() << "\n";
-		return GameResult{ offStats, defStats, !homeWins, homeWins };
+		return GameResult{ offStats, defStats, !homeWins, homeWins, awayTeam->injuries(), homeTeam->injuries() };
 	}
 };
\ No newline at end of file
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "../players/roster.h"
+
+/**
+ * One team as it stood at kickoff: a copy of every player and the depth chart laid over those copies. A game runs on
+ * this instead of the live roster, so it can hand out actions and injuries without touching a real player, and nothing
+ * it does reaches the team until whoever decides the game counts applies injuries() to the roster. Copies share slots
+ * and handles with the roster they came from, so stats recorded against them file under the real players.
+ */
+class TeamSnapshot {
+    Roster* source = nullptr;
+    std::vector<Player> players;    // Never resized after construction, so the depth chart's pointers hold
+    std::vector<int> kickoffWeeks;  // Each player's weeks out at kickoff
+    std::vector<std::vector<Player*>> depthChart;
+
+public:
+    TeamSnapshot() = default;
+
+    // With a kickoff state (saved from this roster earlier in the season), the players are put back the way they were then
+    explicit TeamSnapshot(Roster* roster, const RosterState* kickoff = nullptr) : source(roster) {
+        std::vector<int> bySlot;
+        roster->forEachPlayer([&](Player& player) {
+            int slot = player.getHandle().slot;
+            if (slot >= (int)bySlot.size()) bySlot.resize(slot + 1, -1);
+            bySlot[slot] = players.size();
+            players.push_back(player);
+        });
+        if (kickoff != nullptr) {
+            for (int i = 0; i < (int)players.size(); i++) {
+                players[i].setWeeksInjured(kickoff->weeksInjured[i]);
+                players[i].setGametimeBonus(kickoff->gametimeBonuses[i]);
+            }
+        }
+        for (const Player& player : players) kickoffWeeks.push_back(player.getWeeksInjured());
+        for (Position p : { QB, HB, WR, TE, OL, DL, LB, CB, S, K, P }) {
+            std::vector<Player*> chart;
+            for (Player* player : roster->getDepthChart(p)) chart.push_back(&players[bySlot[player->getHandle().slot]]);
+            depthChart.push_back(chart);
+        }
+    }
+
+    // The depth chart points into players, so a copy would point into someone else's
+    TeamSnapshot(const TeamSnapshot&) = delete;
+    TeamSnapshot& operator=(const TeamSnapshot&) = delete;
+    TeamSnapshot(TeamSnapshot&&) noexcept = default;
+    TeamSnapshot& operator=(TeamSnapshot&&) noexcept = default;
+
+    Roster* getSource() { return source; }
+
+    std::vector<Player*> getElevenMen(const Personnel& personnel) { return Roster::getElevenMen(depthChart, personnel); }
+
+    // Everyone whose weeks out changed since kickoff
+    std::vector<InjuryDelta> injuries() const {
+        std::vector<InjuryDelta> changed;
+        for (int i = 0; i < (int)players.size(); i++) {
+            if (players[i].getWeeksInjured() != kickoffWeeks[i]) changed.push_back({ players[i].getHandle(), players[i].getWeeksInjured() });
+        }
+        return changed;
+    }
+
+    // Undoes the last game's injuries, ready for another game from the same kickoff
+    void reset() {
+        for (int i = 0; i < (int)players.size(); i++) players[i].setWeeksInjured(kickoffWeeks[i]);
+    }
+};
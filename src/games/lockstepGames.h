@@ -0,0 +1,294 @@
+#pragma once
+
+#include "gamePlayer.h"
+
+#include <cstdint>
+
+/**
+ * What one offense gets against one defense, boiled down from their starters so a snap needs no players at all. Runs
+ * and completions keep the engine's own yardage curves and broken tackles. How a pass play ends (sack, pick, catch or
+ * incompletion) is too tangled up with the pocket and the receivers getting open to work out by hand, so it's measured
+ * by running the real pass play over and over.
+ */
+struct LockstepSide {
+    double runAdvantage;    // The composite blocking edge the run curve takes
+    double runBreakChance;  // Chance the runner breaks any one tackle
+    double passBreakChance; // Same for a receiver after the catch
+    double sackChance;
+    double interceptionChance;
+    double completionChance;
+    double kickAccuracy; // Kicker's KICKACCURACY / 100
+    double kickPower;    // Kicker's KICKPOWER / 100
+    int puntDistance;    // Before the punter's normal(0, 3) wobble
+    int coverers;        // Defenders a receiver has to get past
+
+    // Chance of breaking a tackle, averaged over the defenders in proportion to how often each gets the first shot
+    static double breakChance(const std::vector<Player*>& carriers, const std::vector<double>& carrierWeights,
+        const std::vector<Player*>& tacklers, const std::vector<double>& tacklerWeights) {
+        double chance = 0, carrierTotal = 0, tacklerTotal = 0;
+        for (double w : carrierWeights) carrierTotal += w;
+        for (double w : tacklerWeights) tacklerTotal += w;
+        for (int c = 0; c < (int)carriers.size(); c++) {
+            for (int t = 0; t < (int)tacklers.size(); t++) {
+                int factor = GamePlayExecutor::breakTackleFactor(carriers[c], tacklers[t]);
+                double broken = std::max(0, std::min(100, factor + 1)) / 100.0;
+                chance += broken * carrierWeights[c] / carrierTotal * tacklerWeights[t] / tacklerTotal;
+            }
+        }
+        return chance;
+    }
+
+    /**
+     * Everything the real engine would use from the 3 WR 1 TE package, the one it calls most. Plays passSamples real pass
+     * plays on snapshots of both rosters, drawing from RNG::gen.
+     */
+    static LockstepSide measure(Roster* offenseRoster, Roster* defenseRoster, int passSamples) {
+        TeamSnapshot offense(offenseRoster);
+        TeamSnapshot defense(defenseRoster);
+        LockstepSide side;
+        Field field = { offense.getElevenMen(OFFENSIVE_PERSONNEL[3]), defense.getElevenMen(DEFENSIVE_PERSONNEL[3]) };
+        std::vector<Player*>& off = field.first;
+        std::vector<Player*>& def = field.second;
+        Player* quarterback = off[5];
+        Player* halfback = off[6];
+
+        // Runs: the halfback carries with everyone but the quarterback blocking, and all eleven defenders come
+        for (Player* p : off) p->gameState.action = BLOCKING;
+        quarterback->gameState.action = HANDINGOFF;
+        halfback->gameState.action = RUSHING;
+        for (Player* p : def) p->gameState.action = BLITZING;
+        side.runAdvantage = getCompositeRating(getPlayersPerformingAction(off, BLOCKING), RUNBLOCK) / 9.0 -
+            getCompositeRating(def, RUNSTOP) / 11.0;
+        std::vector<double> runStop;
+        for (Player* p : def) runStop.push_back(p->getRating(RUNSTOP) + 70);
+        side.runBreakChance = breakChance({ halfback, quarterback }, { 85, 15 }, def, runStop);
+
+        // Receivers against the seven in coverage
+        std::vector<Player*> coverers(def.begin() + 4, def.end());
+        std::vector<double> coverage;
+        for (Player* p : coverers) coverage.push_back(p->getRating(PASSCOVER) + 40);
+        side.passBreakChance = breakChance({ off[7], off[8], off[9], off[10] }, { 1, 1, 1, 1 }, coverers, coverage);
+        side.coverers = coverers.size();
+
+        int sacks = 0, picks = 0, completions = 0;
+        for (int i = 0; i < passSamples; i++) {
+            for (Player* p : off) p->gameState.action = BLOCKING;
+            quarterback->gameState.action = PASSING;
+            halfback->gameState.action = RNG::randomWeightedIndex({ 4, 5 }) ? RECEIVING : BLOCKING;
+            off[7]->gameState.action = RNG::randomWeightedIndex({ 2, 5 }) ? RECEIVING : BLOCKING;
+            for (int w = 8; w < 11; w++) off[w]->gameState.action = RECEIVING;
+            for (int d = 0; d < 11; d++) def[d]->gameState.action = d < 4 ? BLITZING : COVERING;
+            PlayResult result = GamePlayExecutor::executePlay(PASS, field, 75);
+            if (result.outcome == PASSER_SACKED) sacks++;
+            else if (result.outcome == BALL_PASSED_COMPLETE)
+                completions++;
+            else if (result.incompleteReason == PASS_INCOMPLETE_INTERCEPTED)
+                picks++;
+        }
+        side.sackChance = (double)sacks / passSamples;
+        side.interceptionChance = (double)picks / passSamples;
+        side.completionChance = (double)completions / passSamples;
+
+        Player* kicker = offense.getElevenMen(OFFENSIVE_PERSONNEL[7])[5];
+        Player* punter = offense.getElevenMen(OFFENSIVE_PERSONNEL[8])[5];
+        side.kickAccuracy = kicker->getRating(KICKACCURACY) / 100.0;
+        side.kickPower = kicker->getRating(KICKPOWER) / 100.0;
+        side.puntDistance = std::round(0.4 * punter->getRating(PUNTPOWER)) + 15;
+        return side;
+    }
+};
+
+/**
+ * Plays LANES games of one matchup side by side, one snap at a time. Every game is exactly 144 snaps long, so the lanes
+ * never drift apart: each snap draws every lane's random numbers up front, works out every kind of play for every lane
+ * and keeps the one that lane called, and loops only over plain arrays of game state. A lane's random numbers come from
+ * its own counter-based stream, so there's no shared generator in the way either.
+ *
+ * It's a simpler game than GamePlayer's. The clock is a fixed 144 snaps rather than seconds run off, every snap is played
+ * out of the 3 WR 1 TE package, and nobody gets hurt. Play calls use decidePlay's odds, but each team scores a point or
+ * two a game more than it would in the full engine (benchMatchups prints both), so it's for odds rather than box scores.
+ */
+class LockstepGames {
+public:
+    static constexpr int LANES = 16;
+    static constexpr int PASS_SAMPLES = 1500; // Gets the completion rate to within about 1.3 percentage points
+
+private:
+    static constexpr int SNAPS_PER_QUARTER = 36; // 900 seconds at 25 a snap
+    static constexpr double TWO_PI = 6.283185307179586;
+
+    LockstepSide sides[2]; // Away offense against home defense, then the other way round
+
+    alignas(64) uint64_t streams[LANES];
+    alignas(64) int yardLine[LANES];
+    alignas(64) int down[LANES];
+    alignas(64) int lineToGain[LANES];
+    alignas(64) int homeBall[LANES]; // 1 if the home team has it
+    alignas(64) int points[2][LANES];
+
+    static uint64_t mix(uint64_t z) {
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    // One draw in (0, 1) for every lane, splitmix64 style
+    void uniforms(double* out) {
+        for (int l = 0; l < LANES; l++) out[l] = ((mix(streams[l] += 0x9E3779B97F4A7C15ull) >> 11) + 0.5) * 0x1.0p-53;
+    }
+
+    // One standard normal for every lane
+    void normals(double* out) {
+        alignas(64) double a[LANES], b[LANES];
+        uniforms(a);
+        uniforms(b);
+        for (int l = 0; l < LANES; l++) out[l] = std::sqrt(-2 * std::log(a[l])) * std::cos(TWO_PI * b[l]);
+    }
+
+    // A change of possession with the ball left where it is
+    void flip(int l) {
+        down[l] = 1;
+        yardLine[l] = 100 - yardLine[l];
+        lineToGain[l] = yardLine[l] - 10;
+        homeBall[l] = !homeBall[l];
+    }
+
+    void kickoff(int l, int receivingHome) {
+        down[l] = 1;
+        yardLine[l] = 75;
+        lineToGain[l] = 65;
+        homeBall[l] = receivingHome;
+    }
+
+    void snap() {
+        alignas(64) double callRoll[LANES], yardRoll[LANES], outcomeRoll[LANES], advantage[LANES], normal[LANES];
+        alignas(64) int play[LANES], runYards[LANES], passYards[LANES];
+        uniforms(callRoll);
+        uniforms(yardRoll);
+        uniforms(outcomeRoll);
+        normals(normal); // A play needs at most one: the sack, the kick or the punt. Truncated like RNG::randomNumberNormalDist.
+
+        // GamePlayer::decidePlay
+        for (int l = 0; l < LANES; l++) {
+            int toGo = yardLine[l] - lineToGain[l];
+            int call = callRoll[l] < (toGo < 4 ? 0.3 : 0.6) ? PASS : RUN;
+            if (down[l] == 3 && toGo > 5) call = callRoll[l] < 0.9 ? PASS : RUN;
+            if (down[l] == 4) call = yardLine[l] + 17 <= 50 ? KICK : (yardLine[l] > 40 || toGo > 5) ? PUNT : callRoll[l] < 0.7 ? PASS : RUN;
+            play[l] = call;
+            advantage[l] = sides[homeBall[l]].runAdvantage;
+        }
+        NumberMaker::getRunYardsGained(yardRoll, advantage, runYards, LANES);
+        NumberMaker::getPassYardsGained(yardRoll, passYards, LANES);
+
+        // How each pass ends: 0 sacked, 1 picked, 2 caught, 3 incomplete
+        alignas(64) int passEnd[LANES], gain[LANES], tacklesLeft[LANES];
+        for (int l = 0; l < LANES; l++) {
+            const LockstepSide& s = sides[homeBall[l]];
+            double u = outcomeRoll[l];
+            passEnd[l] = u < s.sackChance ? 0 : u < s.sackChance + s.interceptionChance ? 1 : u < s.sackChance + s.interceptionChance + s.completionChance ? 2 : 3;
+            bool carried = play[l] == RUN || (play[l] == PASS && passEnd[l] == 2);
+            gain[l] = play[l] == RUN ? runYards[l] : passYards[l];
+            tacklesLeft[l] = carried ? (play[l] == RUN ? 11 : s.coverers) : 0;
+        }
+
+        // Broken tackles: every one rerolls the gain and keeps the better, and getting past everybody is a touchdown.
+        // Lanes drop out as their carrier goes down, so only the ones that broke a tackle get packed together for the
+        // reroll, and the loop ends once every carrier is down.
+        alignas(64) double breakRoll[LANES], rerollRoll[LANES], packedAdvantage[LANES];
+        alignas(64) int broke[LANES], rerollRun[LANES], rerollPass[LANES];
+        for (bool anyRunning = true; anyRunning;) {
+            uniforms(breakRoll);
+            uniforms(rerollRoll);
+            int packed = 0;
+            for (int l = 0; l < LANES; l++) {
+                const LockstepSide& s = sides[homeBall[l]];
+                if (tacklesLeft[l] == 0 || breakRoll[l] >= (play[l] == RUN ? s.runBreakChance : s.passBreakChance)) {
+                    tacklesLeft[l] = 0;
+                    continue;
+                }
+                broke[packed] = l;
+                rerollRoll[packed] = rerollRoll[l];
+                packedAdvantage[packed++] = advantage[l];
+            }
+            NumberMaker::getRunYardsGained(rerollRoll, packedAdvantage, rerollRun, packed);
+            NumberMaker::getPassYardsGained(rerollRoll, rerollPass, packed);
+            anyRunning = false;
+            for (int i = 0; i < packed; i++) {
+                int l = broke[i];
+                gain[l] = std::max(gain[l], play[l] == RUN ? rerollRun[i] : rerollPass[i]);
+                if (--tacklesLeft[l] == 0) gain[l] = 100;
+                anyRunning |= tacklesLeft[l] > 0;
+            }
+        }
+
+        // GamePlayer::updateGameState and GameManager
+        for (int l = 0; l < LANES; l++) {
+            const LockstepSide& s = sides[homeBall[l]];
+            int offense = homeBall[l];
+            if (play[l] == KICK) {
+                double odds = -0.027 * (3 - (1.5 * s.kickPower)) * yardLine[l] * yardLine[l] + 80 + (20 * s.kickAccuracy);
+                if ((int)(100 * normal[l]) < odds) {
+                    points[offense][l] += 3;
+                    kickoff(l, !offense);
+                } else
+                    flip(l);
+                continue;
+            }
+            if (play[l] == PUNT) {
+                int yards = std::min(s.puntDistance + (int)(3 * normal[l]), yardLine[l]);
+                yardLine[l] -= yards;
+                if (yardLine[l] == 0) yardLine[l] = 20;
+                flip(l);
+                continue;
+            }
+            int yards = play[l] == RUN ? gain[l] : passEnd[l] == 0 ? std::min((int)(-5 + 2 * normal[l]), -1) : passEnd[l] == 2 ? gain[l] : 0;
+            yardLine[l] -= yards;
+            if (yardLine[l] <= 0) {
+                points[offense][l] += 7;
+                kickoff(l, !offense);
+                continue;
+            }
+            down[l]++;
+            if (yardLine[l] <= lineToGain[l]) {
+                down[l] = 1;
+                lineToGain[l] = yardLine[l] - 10;
+            } else if (down[l] == 5)
+                flip(l);
+            if (play[l] == PASS && passEnd[l] == 1) flip(l);
+        }
+    }
+
+public:
+    // Measures both sides from the rosters, which are left as they were. The calling thread's RNG is put back.
+    LockstepGames(Roster* awayRoster, Roster* homeRoster, unsigned seed, int passSamples = PASS_SAMPLES) {
+        std::mt19937 callersGen = RNG::gen;
+        RNG::gen.seed(seed);
+        sides[0] = LockstepSide::measure(awayRoster, homeRoster, passSamples);
+        sides[1] = LockstepSide::measure(homeRoster, awayRoster, passSamples);
+        RNG::gen = callersGen;
+        reseed(seed);
+    }
+
+    // Restarts every lane's random numbers, so the same seed plays the same games again
+    void reseed(unsigned seed) {
+        for (int l = 0; l < LANES; l++) streams[l] = mix((uint64_t)seed * LANES + l);
+    }
+
+    const LockstepSide& getSide(bool homeOffense) const { return sides[homeOffense]; }
+
+    // Plays the next LANES games and hands back each one's final score
+    void play(int* awayPoints, int* homePoints) {
+        for (int l = 0; l < LANES; l++) {
+            points[0][l] = points[1][l] = 0;
+            kickoff(l, 0);
+        }
+        for (int quarter = 0; quarter < 4; quarter++) {
+            if (quarter == 2) {
+                for (int l = 0; l < LANES; l++) kickoff(l, 1);
+            }
+            for (int i = 0; i < SNAPS_PER_QUARTER; i++) snap();
+        }
+        std::copy(points[0], points[0] + LANES, awayPoints);
+        std::copy(points[1], points[1] + LANES, homePoints);
+    }
+};
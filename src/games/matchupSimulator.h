@@ -0,0 +1,225 @@
+#pragma once
+
+#include "gamePlayer.h"
+#include "lockstepGames.h"
+
+#include <array>
+#include <memory>
+
+// What a batch of replays of one matchup adds up to
+struct MatchupOdds {
+    static constexpr int MAX_MARGIN = 70;
+
+    int games = 0;
+    int awayWins = 0;
+    int homeWins = 0;
+    int ties = 0;
+    long long awayPoints = 0;
+    long long homePoints = 0;
+    long long awayPointsSquared = 0;
+    long long homePointsSquared = 0;
+    std::array<int, 2 * MAX_MARGIN + 1> margins{}; // Away points minus home points, clamped to +/- MAX_MARGIN
+    TeamStats awayStats;                           // Summed over every game
+    TeamStats homeStats;
+    double milliseconds = 0;
+
+    MatchupOdds() {
+        awayStats.games = 0;
+        homeStats.games = 0;
+    }
+
+    void record(TeamStats& away, TeamStats& home) {
+        recordScore(away.points, home.points);
+        awayStats += away;
+        homeStats += home;
+    }
+
+    // Just the final score, for engines that don't keep stats
+    void recordScore(int away, int home) {
+        games++;
+        if (away > home) awayWins++;
+        else if (home > away)
+            homeWins++;
+        else
+            ties++;
+        awayPoints += away;
+        homePoints += home;
+        awayPointsSquared += away * away;
+        homePointsSquared += home * home;
+        margins[std::max(-MAX_MARGIN, std::min(MAX_MARGIN, away - home)) + MAX_MARGIN]++;
+    }
+
+    void add(MatchupOdds& other) {
+        games += other.games;
+        awayWins += other.awayWins;
+        homeWins += other.homeWins;
+        ties += other.ties;
+        awayPoints += other.awayPoints;
+        homePoints += other.homePoints;
+        awayPointsSquared += other.awayPointsSquared;
+        homePointsSquared += other.homePointsSquared;
+        for (int i = 0; i < (int)margins.size(); i++) margins[i] += other.margins[i];
+        awayStats += other.awayStats;
+        homeStats += other.homeStats;
+    }
+
+    // The away team's chance of winning a game that has a winner
+    std::pair<double, double> awayWinInterval() const { return wilsonInterval(awayWins, std::max(1, awayWins + homeWins)); }
+
+    double intervalWidth() const {
+        std::pair<double, double> ci = awayWinInterval();
+        return ci.second - ci.first;
+    }
+
+    double gamesPerSecond() const { return milliseconds > 0 ? games * 1000.0 / milliseconds : 0; }
+
+    // The away margin that fraction of games fell at or below
+    int marginPercentile(double fraction) const {
+        int seen = 0;
+        for (int i = 0; i < (int)margins.size(); i++) {
+            seen += margins[i];
+            if (seen >= fraction * games) return i - MAX_MARGIN;
+        }
+        return MAX_MARGIN;
+    }
+
+    void print(School* away, School* home) {
+        auto stdev = [this](long long total, long long squared) {
+            double mean = (double)total / games;
+            return std::sqrt(std::max(0.0, (double)squared / games - mean * mean));
+        };
+        std::pair<double, double> ci = awayWinInterval();
+        printf("Simulated %d games in %.0f ms (%.0f games/sec)\n", games, milliseconds, gamesPerSecond());
+        std::cout << "\nAway - home wins: " << awayWins << " - " << homeWins << " (" << ties << " ties)\n";
+        printf("Away won %.1f%% of the time (95%% interval %.1f%% - %.1f%%)\n", 100.0 * awayWins / std::max(1, awayWins + homeWins),
+            100 * ci.first, 100 * ci.second);
+        printf("Average score: %s %.1f (+/- %.1f), %s %.1f (+/- %.1f)\n", away->getName().c_str(), (double)awayPoints / games,
+            stdev(awayPoints, awayPointsSquared), home->getName().c_str(), (double)homePoints / games, stdev(homePoints, homePointsSquared));
+        printf("Away margin: %d / %d / %d (10th / 50th / 90th percentile)\n\n", marginPercentile(0.1), marginPercentile(0.5),
+            marginPercentile(0.9));
+        std::cout << "AWAY STATS:\n";
+        awayStats.printBigStuff();
+        std::cout << "\nHOME STATS:\n";
+        homeStats.printBigStuff();
+    }
+};
+
+/**
+ * Replays one matchup over and over on snapshots of both rosters, so nothing that happens in a replay (injuries above
+ * all) reaches the real teams. Each worker snapshots the rosters once up front and reuses its own stats for every game,
+ * resetting the snapshots in between. Replays run in batches across every core until the away team's win chance is known closely
+ * enough.
+ */
+class MatchupSimulator {
+    static constexpr int GAMES_PER_CHUNK = 25;
+    static constexpr int LOCKSTEP_GAMES_PER_CHUNK = 2 * LockstepGames::LANES; // Whole batches, so no lane is played for nothing
+
+    struct Worker {
+        TeamSnapshot awaySnapshot;
+        TeamSnapshot homeSnapshot;
+        TeamStats awayGame;
+        TeamStats homeGame;
+        MatchupOdds odds;
+        std::unique_ptr<LockstepGames> lockstep; // A copy of the sides measured the first time they're needed
+    };
+
+    School* away;
+    School* home;
+    std::vector<Worker> workers;
+
+    void playGame(Worker& w) {
+        w.awaySnapshot.reset();
+        w.homeSnapshot.reset();
+        w.awayGame.clearForReuse();
+        w.homeGame.clearForReuse();
+        GamePlayer game(away, home, &w.awaySnapshot, &w.homeSnapshot, &w.awayGame, &w.homeGame);
+        GameResult result = game.startRealTimeGameLoop(false);
+        w.odds.record(*result.awayStats, *result.homeStats);
+    }
+
+public:
+    // threads of 0 means one per core
+    MatchupSimulator(School* awaySchool, School* homeSchool, int threads = 0) : away(awaySchool), home(homeSchool) {
+        workers.resize(threads > 0 ? threads : std::max(1u, std::thread::hardware_concurrency()));
+        for (Worker& w : workers) {
+            w.awaySnapshot = TeamSnapshot(away->getRoster());
+            w.homeSnapshot = TeamSnapshot(home->getRoster());
+        }
+    }
+
+    /**
+     * Plays up to maxGames, stopping early once the 95% interval on the away team's win chance is narrower than
+     * maxIntervalWidth. Each worker seeds its own RNG from seed, and puts back whatever the calling thread's was.
+     */
+    MatchupOdds run(int maxGames, double maxIntervalWidth, unsigned seed) {
+        auto start = std::chrono::steady_clock::now();
+        for (Worker& w : workers) w.odds = MatchupOdds();
+        MatchupOdds total;
+        for (int batch = 0; total.games < maxGames; batch++) {
+            int remaining = maxGames - total.games;
+            int chunks = std::min((int)workers.size(), (remaining + GAMES_PER_CHUNK - 1) / GAMES_PER_CHUNK);
+            parallelFor(chunks, [&](int c) {
+                std::mt19937 callersGen = RNG::gen;
+                std::seed_seq seeds{ seed, (unsigned)batch, (unsigned)c };
+                RNG::gen.seed(seeds);
+                int games = std::min(GAMES_PER_CHUNK, remaining - c * GAMES_PER_CHUNK);
+                for (int i = 0; i < games; i++) playGame(workers[c]);
+                RNG::gen = callersGen;
+            });
+            total.games = total.awayWins = total.homeWins = 0;
+            for (Worker& w : workers) {
+                total.games += w.odds.games;
+                total.awayWins += w.odds.awayWins;
+                total.homeWins += w.odds.homeWins;
+            }
+            if (total.intervalWidth() < maxIntervalWidth) break;
+        }
+        total = MatchupOdds();
+        for (Worker& w : workers) total.add(w.odds);
+        // Handles match between a roster and its copies, so the real rosters can look up these players
+        total.awayStats.roster = away->getRoster();
+        total.homeStats.roster = home->getRoster();
+        total.milliseconds = elapsedMs(start);
+        return total;
+    }
+
+    /**
+     * The same, through the lockstep engine: every chunk plays LockstepGames::LANES games at a time. Only the scores are
+     * kept, so the summed stats stay empty.
+     */
+    MatchupOdds runLockstep(int maxGames, double maxIntervalWidth, unsigned seed) {
+        auto start = std::chrono::steady_clock::now();
+        const int lanes = LockstepGames::LANES;
+        MatchupOdds total;
+        std::vector<MatchupOdds> odds(workers.size());
+        // Measuring is thousands of real plays and comes out the same for every worker, so it's only done once
+        if (!workers[0].lockstep) {
+            LockstepGames measured(away->getRoster(), home->getRoster(), seed);
+            for (Worker& w : workers) w.lockstep = std::make_unique<LockstepGames>(measured);
+        }
+        for (int batch = 0; total.games < maxGames; batch++) {
+            int remaining = maxGames - total.games;
+            int chunks = std::min((int)workers.size(), (remaining + LOCKSTEP_GAMES_PER_CHUNK - 1) / LOCKSTEP_GAMES_PER_CHUNK);
+            parallelFor(chunks, [&](int c) {
+                std::seed_seq seeds{ seed, (unsigned)batch, (unsigned)c };
+                std::vector<unsigned> chunkSeed(1);
+                seeds.generate(chunkSeed.begin(), chunkSeed.end());
+                LockstepGames& games = *workers[c].lockstep;
+                games.reseed(chunkSeed[0]);
+                int awayPoints[lanes], homePoints[lanes];
+                int wanted = std::min(LOCKSTEP_GAMES_PER_CHUNK, remaining - c * LOCKSTEP_GAMES_PER_CHUNK);
+                for (int played = 0; played < wanted; played += lanes) {
+                    games.play(awayPoints, homePoints);
+                    for (int l = 0; l < lanes && played + l < wanted; l++) odds[c].recordScore(awayPoints[l], homePoints[l]);
+                }
+            });
+            total = MatchupOdds();
+            for (MatchupOdds& o : odds) total.add(o);
+            if (total.intervalWidth() < maxIntervalWidth) break;
+        }
+        total.awayStats.roster = away->getRoster();
+        total.homeStats.roster = home->getRoster();
+        total.milliseconds = elapsedMs(start);
+        return total;
+    }
+};
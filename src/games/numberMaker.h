@@ -2,32 +2,154 @@
 
 #include "../util.h"
 
+#include <vector>
+
+/**
+ * Inverse CDF of floor(STEPS_PER_YARD * curve(x)) for x uniform on [0, 1). The curve has to be increasing between its
+ * break points, but can jump either way at them. Every place the value changes is found up front by bisection, so a
+ * draw is one bucket lookup and hardly ever a step past it.
+ */
+class InverseCdfTable {
+    static constexpr int BUCKETS = 4096;
+
+    std::vector<double> starts; // Where each run of one value starts, in order
+    std::vector<int> values;    // The value from that start up to the next
+    std::vector<int> firstRun;  // The run each bucket of x starts in
+
+public:
+    static constexpr int STEPS_PER_YARD = 10;
+
+    template<class Curve>
+    InverseCdfTable(Curve curve, std::vector<double> breaks) {
+        auto step = [&](double x) { return (int)std::floor(STEPS_PER_YARD * curve(x)); };
+        breaks.insert(breaks.begin(), 0.0);
+        breaks.push_back(1.0);
+        for (int piece = 0; piece + 1 < (int)breaks.size(); piece++) {
+            double from = breaks[piece];
+            double to = breaks[piece + 1];
+            int value = step(from);
+            int last = step(std::nextafter(to, 0.0));
+            starts.push_back(from);
+            values.push_back(value);
+            while (value < last) {
+                // The first x in the piece past the current value, down to the last bit
+                double below = starts.back();
+                double above = to;
+                while (true) {
+                    double mid = below + (above - below) / 2;
+                    if (mid <= below || mid >= above) break;
+                    (step(mid) > value ? above : below) = mid;
+                }
+                value = step(above);
+                starts.push_back(above);
+                values.push_back(value);
+            }
+        }
+        int run = 0;
+        for (int b = 0; b < BUCKETS; b++) {
+            while (run + 1 < (int)starts.size() && starts[run + 1] <= (double)b / BUCKETS) run++;
+            firstRun.push_back(run);
+        }
+    }
+
+    int operator()(double x) const {
+        int run = firstRun[std::max(0, std::min(BUCKETS - 1, (int)(x * BUCKETS)))];
+        while (run + 1 < (int)starts.size() && x >= starts[run + 1]) run++;
+        return values[run];
+    }
+
+    int size() const { return starts.size(); }
+};
+
 class NumberMaker {
+    // Tenths of a yard, floored
+    static const InverseCdfTable& runTable() {
+        static const InverseCdfTable table([](double x) { return runYardsCurve(x, 0); }, { 0.95 });
+        return table;
+    }
+
+    static const InverseCdfTable& passTable() {
+        static const InverseCdfTable table(passYardsCurve, { 0.15, 0.9 });
+        return table;
+    }
+
+    // Rounds tenths of a yard to the nearest yard, half up
+    static int nearestYard(int tenths) {
+        int n = tenths + InverseCdfTable::STEPS_PER_YARD / 2;
+        return n >= 0 ? n / InverseCdfTable::STEPS_PER_YARD : -((-n + InverseCdfTable::STEPS_PER_YARD - 1) / InverseCdfTable::STEPS_PER_YARD);
+    }
+
+    // Chance that a normal(0, 1) draw is below z, for z in hundredths from -6 to 6
+    static double normalBelow(int hundredths) {
+        static const std::vector<double> table = [] {
+            std::vector<double> t;
+            for (int h = -600; h <= 600; h++) t.push_back(0.5 * std::erfc(-h / 100.0 / std::sqrt(2.0)));
+            return t;
+        }();
+        return table[std::max(-600, std::min(600, hundredths)) + 600];
+    }
 
 public:
-    static int getRunYardsGained(double blockingAdvantage) {
-        double x = RNG::randomNumberUniformDist();
+    // The yardage curves, taking the uniform draw x in [0, 1)
+    static double runYardsCurve(double x, double blockingAdvantage) {
         if (x < 0.95) {
-            return std::round(6 * std::log(x + 0.1) + 8 + (blockingAdvantage / 10.0));
+            return 6 * std::log(x + 0.1) + 8 + (blockingAdvantage / 10.0);
         } else {
-            return std::round(std::pow(25, 7 * (x - 0.78)) - 37.8 + (blockingAdvantage / 10.0));
+            return std::pow(25, 7 * (x - 0.78)) - 37.8 + (blockingAdvantage / 10.0);
         }
     }
 
-    static int getPassYardsGained() {
-        double x = RNG::randomNumberUniformDist();
+    static double passYardsCurve(double x) {
         if (x < 0.15) {
-            return std::round((80 * x) - 12);
+            return (80 * x) - 12;
         } else if (x < 0.9) {
-            return std::round(18 * std::pow(x, 2));
+            return 18 * std::pow(x, 2);
         } else {
-            return std::round(std::pow(2, 7.71 * x) - 108.12);
+            return std::pow(2, 7.71 * x) - 108.12;
+        }
+    }
+
+    /**
+     * Draws from the curves through their tables. The blocking advantage only ever slides the run curve along, by a tenth
+     * of a yard per point, so rounding it to a whole point turns the run table for every advantage into one table and a
+     * shift.
+     */
+    static int getRunYardsGained(double blockingAdvantage) {
+        return nearestYard(runTable()(RNG::randomNumberUniformDist()) + (int)std::lround(blockingAdvantage));
+    }
+
+    static int getPassYardsGained() { return nearestYard(passTable()(RNG::randomNumberUniformDist())); }
+
+    /**
+     * Whole batches of draws at once, for engines that play many games side by side. Both curves are worked out for
+     * every lane and the right one picked afterwards, so the loops have no branches to keep them from vectorizing.
+     */
+    static void getRunYardsGained(const double* x, const double* blockingAdvantage, int* yards, int n) {
+        for (int i = 0; i < n; i++) {
+            double common = 6 * std::log(x[i] + 0.1) + 8;
+            double breakaway = std::pow(25.0, 7 * (x[i] - 0.78)) - 37.8;
+            yards[i] = (int)std::lround((x[i] < 0.95 ? common : breakaway) + blockingAdvantage[i] / 10.0);
+        }
+    }
+
+    static void getPassYardsGained(const double* x, int* yards, int n) {
+        for (int i = 0; i < n; i++) {
+            double checkdown = 80 * x[i] - 12;
+            double intermediate = 18 * (x[i] * x[i]);
+            double deep = std::pow(2.0, 7.71 * x[i]) - 108.12;
+            yards[i] = (int)std::lround(x[i] < 0.15 ? checkdown : x[i] < 0.9 ? intermediate : deep);
         }
     }
 
+    /**
+     * The kick is good if a normal(0, 100) draw, truncated toward zero, comes up under the odds. The chance of that only
+     * depends on the whole number just under the odds, so it comes from a table and a single uniform draw.
+     */
     static bool didFieldGoalSucceed(int yardLine, double accuracyFactor, double powerFactor) {
-        double odds = -0.027 * (3 - (1.5 * powerFactor)) * pow(yardLine, 2);
+        double odds = -0.027 * (3 - (1.5 * powerFactor)) * (yardLine * yardLine);
         odds += 80 + (20 * accuracyFactor);
-        return (RNG::randomNumberNormalDist(0, 100) < odds);
+        int highestGood = (int)std::ceil(odds) - 1; // The highest truncated draw that's still under the odds
+        double chance = highestGood >= 0 ? normalBelow(highestGood + 1) : normalBelow(highestGood);
+        return RNG::randomNumberUniformDist() < chance;
     }
 };
\ No newline at end of file
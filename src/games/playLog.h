@@ -0,0 +1,508 @@
+#pragma once
+
+#include "gamePlayExecutor.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <queue>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/**
+ * One snap, packed into 12 bytes. The situation is as it stood before the snap; the rest is what the play did. Players
+ * are referred to by their roster slot, which stays put for the whole season (rosters only turn over in the offseason).
+ */
+struct PlayRecord {
+    static constexpr uint16_t NOBODY = 0xFFFF;
+
+    uint16_t clock;           // Seconds played since kickoff, so the quarter is clock / 900 + 1
+    uint16_t carrier;         // Runner, receiver, kicker or punter
+    uint16_t defender;        // Tackler, or whoever broke up the pass
+    uint8_t down;
+    uint8_t yardsToGo;
+    uint8_t yardLine;         // Yards from the end zone the offense is going for
+    uint8_t play : 3;         // PlayType
+    uint8_t formation : 4;    // GamePlayer::OffensiveFormation
+    uint8_t homeOffense : 1;
+    uint8_t outcome : 3;      // PlayOutcome
+    uint8_t incomplete : 3;   // IncompleteReason, for passes that weren't caught
+    uint8_t touchdown : 1;
+    uint8_t driveStart : 1;   // First snap since the offense got the ball
+    int8_t yards;             // Gained on offense, or the length of a kick
+
+    int quarter() const { return clock / 900 + 1; }
+    bool isScrimmage() const { return play == RUN || play == PASS; }
+    bool converted() const { return touchdown || (isScrimmage() && yards >= yardsToGo && outcome != BALL_PASSED_INCOMPLETE); }
+};
+static_assert(sizeof(PlayRecord) == 12, "PlayRecord should pack into 12 bytes");
+
+// Where one game's snaps sit in a season's log
+struct LoggedGame {
+    uint32_t firstPlay;
+    uint16_t numPlays;
+    uint16_t away; // School ids, indexing the log's school names
+    uint16_t home;
+    uint16_t awayPoints;
+    uint16_t homePoints;
+    uint8_t week;
+    uint8_t unused = 0;
+};
+static_assert(sizeof(LoggedGame) == 16, "LoggedGame should pack into 16 bytes");
+
+// Read-only access to a log, whether it lives in a PlayLog or in a mapped file
+struct PlayLogView {
+    const std::vector<std::string>* schoolNames = nullptr;
+    const LoggedGame* games = nullptr;
+    size_t numGames = 0;
+    const PlayRecord* plays = nullptr;
+    size_t numPlays = 0;
+
+    const PlayRecord* begin(const LoggedGame& game) const { return plays + game.firstPlay; }
+    const PlayRecord* end(const LoggedGame& game) const { return plays + game.firstPlay + game.numPlays; }
+};
+
+// Byte k of every record, less a guess from the same byte of the record before: nothing, its value, or its value plus
+// the step it took
+std::vector<uint8_t> playResiduals(const PlayRecord* plays, size_t numPlays, size_t k, int order) {
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(plays);
+    std::vector<uint8_t> residuals(numPlays);
+    uint8_t last = 0, step = 0;
+    for (size_t i = 0; i < numPlays; i++) {
+        uint8_t b = bytes[i * sizeof(PlayRecord) + k];
+        uint8_t guess = order == 0 ? 0 : order == 1 ? last : (uint8_t)(last + step);
+        residuals[i] = b - guess;
+        step = b - last;
+        last = b;
+    }
+    return residuals;
+}
+
+// Huffman code lengths for these byte counts. Every byte that turns up gets a code, even when it's the only one.
+std::array<uint8_t, 256> huffmanLengths(const std::array<size_t, 256>& counts) {
+    std::array<uint8_t, 256> lengths{};
+    using Node = std::pair<size_t, int>; // Weight, then node (the first 256 are the bytes themselves)
+    std::priority_queue<Node, std::vector<Node>, std::greater<Node>> queue;
+    std::vector<int> parent(256, -1);
+    for (int b = 0; b < 256; b++) {
+        if (counts[b] > 0) queue.emplace(counts[b], b);
+    }
+    if (queue.size() == 1) lengths[queue.top().second] = 1;
+    while (queue.size() > 1) {
+        Node a = queue.top();
+        queue.pop();
+        Node b = queue.top();
+        queue.pop();
+        parent.push_back(-1);
+        parent[a.second] = parent[b.second] = parent.size() - 1;
+        queue.emplace(a.first + b.first, parent.size() - 1);
+    }
+    for (int b = 0; b < 256; b++) {
+        for (int n = b; counts[b] > 0 && parent[n] >= 0; n = parent[n]) lengths[b]++;
+    }
+    return lengths;
+}
+
+// Bytes in order of code length, then value, which is the order canonical codes get handed out in
+std::vector<int> canonicalOrder(const std::array<uint8_t, 256>& lengths) {
+    std::vector<int> order;
+    for (int b = 0; b < 256; b++) {
+        if (lengths[b] > 0) order.push_back(b);
+    }
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b) { return lengths[a] < lengths[b]; });
+    return order;
+}
+
+/**
+ * Packs a run of records column by column. Each column (byte k of every record) is first turned into residuals against
+ * whichever guess from the record before suits it best: the clock always moves on by the same step, and the down or
+ * whose ball it is seldom changes, so those columns are nearly all zeros. The residuals are then Huffman coded, with the
+ * code lengths stored up front so the code can be rebuilt.
+ */
+std::vector<uint8_t> compressPlays(const PlayRecord* plays, size_t numPlays) {
+    std::vector<uint8_t> packed;
+    for (size_t k = 0; k < sizeof(PlayRecord); k++) {
+        std::vector<uint8_t> best;
+        std::array<size_t, 256> bestCounts{};
+        int bestOrder = 0;
+        double bestBits = 0;
+        for (int order = 0; order < 3; order++) {
+            std::vector<uint8_t> residuals = playResiduals(plays, numPlays, k, order);
+            std::array<size_t, 256> counts{};
+            for (uint8_t r : residuals) counts[r]++;
+            double bits = 0; // Entropy, which is within a bit a byte of what the code will take
+            for (size_t c : counts) {
+                if (c > 0) bits -= c * std::log2((double)c / numPlays);
+            }
+            if (order == 0 || bits < bestBits) {
+                best = std::move(residuals);
+                bestCounts = counts;
+                bestOrder = order;
+                bestBits = bits;
+            }
+        }
+
+        std::array<uint8_t, 256> lengths = huffmanLengths(bestCounts);
+        std::array<uint64_t, 256> codes{};
+        uint64_t code = 0;
+        int length = 0;
+        for (int b : canonicalOrder(lengths)) {
+            code <<= lengths[b] - length;
+            length = lengths[b];
+            codes[b] = code++;
+        }
+        packed.push_back(bestOrder);
+        packed.insert(packed.end(), lengths.begin(), lengths.end());
+        uint8_t pending = 0;
+        int pendingBits = 0;
+        for (uint8_t r : best) {
+            for (int bit = lengths[r] - 1; bit >= 0; bit--) {
+                pending = (pending << 1) | ((codes[r] >> bit) & 1);
+                if (++pendingBits == 8) {
+                    packed.push_back(pending);
+                    pendingBits = 0;
+                }
+            }
+        }
+        if (pendingBits > 0) packed.push_back(pending << (8 - pendingBits));
+    }
+    return packed;
+}
+
+// Undoes compressPlays. Returns false if the bytes don't hold exactly numPlays records.
+bool decompressPlays(const uint8_t* packed, size_t packedSize, size_t numPlays, PlayRecord* plays) {
+    uint8_t* bytes = reinterpret_cast<uint8_t*>(plays);
+    size_t at = 0;
+    for (size_t k = 0; k < sizeof(PlayRecord); k++) {
+        if (packedSize - at < 257 || packed[at] > 2) return false;
+        int order = packed[at++];
+        std::array<uint8_t, 256> lengths;
+        std::copy(packed + at, packed + at + 256, lengths.begin());
+        at += 256;
+        std::vector<int> symbols = canonicalOrder(lengths);
+        std::vector<int> perLength(65, 0);
+        for (int b : symbols) {
+            if (lengths[b] > 64) return false;
+            perLength[lengths[b]]++;
+        }
+
+        uint8_t last = 0, step = 0;
+        int bitsLeft = 0;
+        uint8_t current = 0;
+        for (size_t i = 0; i < numPlays; i++) {
+            // Walks down the code one bit at a time; codes of each length follow on from the shorter ones
+            uint64_t code = 0, first = 0;
+            int index = 0, residual = -1;
+            for (int length = 1; length <= 64 && residual < 0; length++) {
+                if (bitsLeft == 0) {
+                    if (at == packedSize) return false;
+                    current = packed[at++];
+                    bitsLeft = 8;
+                }
+                code |= (current >> --bitsLeft) & 1;
+                if (code - first < (uint64_t)perLength[length]) residual = symbols[index + code - first];
+                index += perLength[length];
+                first = (first + perLength[length]) << 1;
+                code <<= 1;
+            }
+            if (residual < 0) return false;
+            uint8_t guess = order == 0 ? 0 : order == 1 ? last : (uint8_t)(last + step);
+            uint8_t b = guess + residual;
+            bytes[i * sizeof(PlayRecord) + k] = b;
+            step = b - last;
+            last = b;
+        }
+    }
+    return at == packedSize;
+}
+
+/**
+ * Every snap of a season's play-by-play games, appended game by game. Can be written to disk as is, or compressed; the
+ * uncompressed file is laid out so that MappedPlayLog can map it and read the records in place.
+ */
+class PlayLog {
+    struct FileHeader {
+        char magic[8];
+        uint32_t version;
+        uint32_t compressed;
+        uint32_t numSchools;
+        uint32_t numGames;
+        uint64_t numPlays;
+        uint64_t namesOffset; // NUL-terminated names, one after another
+        uint64_t gamesOffset;
+        uint64_t playsOffset;
+        uint64_t playsBytes;
+    };
+    static constexpr char MAGIC[8] = { 'C', 'F', 'B', 'P', 'L', 'A', 'Y', 'S' };
+    static constexpr uint32_t VERSION = 1;
+
+    std::vector<std::string> schoolNames;
+    std::unordered_map<std::string, int> schoolIds;
+    std::vector<LoggedGame> games;
+    std::vector<PlayRecord> plays;
+
+    friend class MappedPlayLog;
+
+    static uint64_t alignTo8(uint64_t offset) { return (offset + 7) & ~(uint64_t)7; }
+
+    /**
+     * Checks the header, the offsets and counts it gives, and every game against a file of fileSize bytes, and reads the
+     * school names. Nothing in the file is trusted: a truncated or corrupt log is turned away here rather than read past
+     * the end of later. Sizes are compared by dividing, so a huge count can't wrap around.
+     */
+    static bool readLayout(const uint8_t* file, size_t fileSize, FileHeader& header, std::vector<std::string>& names) {
+        if (fileSize < sizeof(FileHeader)) return false;
+        std::memcpy(&header, file, sizeof(FileHeader));
+        if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION) return false;
+        // The sections come in order, inside the file, with games and plays on the 8-byte boundaries save() puts them on
+        if (header.namesOffset < sizeof(FileHeader) || header.namesOffset > header.gamesOffset) return false;
+        if (header.gamesOffset > header.playsOffset || header.playsOffset > fileSize) return false;
+        if (header.gamesOffset % 8 != 0 || header.playsOffset % 8 != 0) return false;
+        if (header.numGames > (header.playsOffset - header.gamesOffset) / sizeof(LoggedGame)) return false;
+        if (header.playsBytes > fileSize - header.playsOffset) return false;
+        if (header.compressed) {
+            // Every Huffman code is at least a bit long, so each column takes at least a bit a record
+            if (header.numPlays > header.playsBytes * 8 / sizeof(PlayRecord)) return false;
+        } else if (header.numPlays != header.playsBytes / sizeof(PlayRecord) || header.playsBytes % sizeof(PlayRecord) != 0)
+            return false;
+        for (uint32_t g = 0; g < header.numGames; g++) {
+            LoggedGame game;
+            std::memcpy(&game, file + header.gamesOffset + g * sizeof(LoggedGame), sizeof(LoggedGame));
+            if (game.firstPlay > header.numPlays || game.numPlays > header.numPlays - game.firstPlay) return false;
+            if (game.away >= header.numSchools || game.home >= header.numSchools) return false;
+        }
+        names.clear();
+        const char* name = reinterpret_cast<const char*>(file + header.namesOffset);
+        const char* namesEnd = reinterpret_cast<const char*>(file + header.gamesOffset);
+        for (uint32_t i = 0; i < header.numSchools; i++) {
+            size_t length = strnlen(name, namesEnd - name);
+            if (name + length == namesEnd) return false;
+            names.emplace_back(name, length);
+            name += length + 1;
+        }
+        return true;
+    }
+
+public:
+    int schoolId(const std::string& name) {
+        auto found = schoolIds.find(name);
+        if (found != schoolIds.end()) return found->second;
+        schoolNames.push_back(name);
+        return schoolIds[name] = schoolNames.size() - 1;
+    }
+
+    const std::vector<std::string>& getSchoolNames() const { return schoolNames; }
+
+    void addGame(int week, const std::string& away, const std::string& home, const std::vector<PlayRecord>& snaps, int awayPoints,
+        int homePoints) {
+        LoggedGame game;
+        game.firstPlay = plays.size();
+        game.numPlays = snaps.size();
+        game.away = schoolId(away);
+        game.home = schoolId(home);
+        game.awayPoints = awayPoints;
+        game.homePoints = homePoints;
+        game.week = week;
+        games.push_back(game);
+        plays.insert(plays.end(), snaps.begin(), snaps.end());
+    }
+
+    void clear() {
+        games.clear();
+        plays.clear();
+    }
+
+    size_t numGames() const { return games.size(); }
+    size_t numPlays() const { return plays.size(); }
+
+    PlayLogView view() const { return { &schoolNames, games.data(), games.size(), plays.data(), plays.size() }; }
+
+    bool save(const std::string& path, bool compress) const {
+        FileHeader header{};
+        std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+        header.version = VERSION;
+        header.compressed = compress;
+        header.numSchools = schoolNames.size();
+        header.numGames = games.size();
+        header.numPlays = plays.size();
+
+        std::string names;
+        for (const std::string& name : schoolNames) names.append(name.c_str(), name.size() + 1);
+        std::vector<uint8_t> packed;
+        if (compress) packed = compressPlays(plays.data(), plays.size());
+        header.namesOffset = sizeof(FileHeader);
+        header.gamesOffset = alignTo8(header.namesOffset + names.size());
+        header.playsOffset = alignTo8(header.gamesOffset + games.size() * sizeof(LoggedGame));
+        header.playsBytes = compress ? packed.size() : plays.size() * sizeof(PlayRecord);
+
+        FILE* file = std::fopen(path.c_str(), "wb");
+        if (file == nullptr) return false;
+        const char padding[8] = {};
+        bool ok = std::fwrite(&header, sizeof(header), 1, file) == 1;
+        ok = ok && std::fwrite(names.data(), 1, names.size(), file) == names.size();
+        ok = ok && std::fwrite(padding, 1, header.gamesOffset - header.namesOffset - names.size(), file) ==
+            header.gamesOffset - header.namesOffset - names.size();
+        ok = ok && std::fwrite(games.data(), sizeof(LoggedGame), games.size(), file) == games.size();
+        size_t gap = header.playsOffset - header.gamesOffset - games.size() * sizeof(LoggedGame);
+        ok = ok && std::fwrite(padding, 1, gap, file) == gap;
+        const void* body = compress ? (const void*)packed.data() : (const void*)plays.data();
+        ok = ok && std::fwrite(body, 1, header.playsBytes, file) == header.playsBytes;
+        return std::fclose(file) == 0 && ok;
+    }
+
+    // Reads a saved log of either kind into memory, replacing whatever this one held
+    bool load(const std::string& path) {
+        FILE* file = std::fopen(path.c_str(), "rb");
+        if (file == nullptr) return false;
+        std::vector<uint8_t> bytes;
+        uint8_t buffer[1 << 16];
+        for (size_t n; (n = std::fread(buffer, 1, sizeof(buffer), file)) > 0;) bytes.insert(bytes.end(), buffer, buffer + n);
+        std::fclose(file);
+
+        FileHeader header;
+        std::vector<std::string> names;
+        if (!readLayout(bytes.data(), bytes.size(), header, names)) return false;
+        std::vector<PlayRecord> records(header.numPlays);
+        const uint8_t* body = bytes.data() + header.playsOffset;
+        if (header.compressed) {
+            if (!decompressPlays(body, header.playsBytes, header.numPlays, records.data())) return false;
+        } else
+            std::memcpy(records.data(), body, header.playsBytes);
+
+        schoolNames = names;
+        schoolIds.clear();
+        for (int i = 0; i < (int)schoolNames.size(); i++) schoolIds[schoolNames[i]] = i;
+        games.resize(header.numGames);
+        std::memcpy(games.data(), bytes.data() + header.gamesOffset, header.numGames * sizeof(LoggedGame));
+        plays = std::move(records);
+        return true;
+    }
+};
+
+/**
+ * An uncompressed log file read in place. Where there's no mmap, the file is read into memory instead, which gives the
+ * same view at the cost of the copy.
+ */
+class MappedPlayLog {
+    std::vector<std::string> schoolNames;
+    PlayLogView contents;
+    const uint8_t* base = nullptr;
+    size_t size = 0;
+    std::vector<uint8_t> copy;
+
+    void close() {
+#if defined(__unix__) || defined(__APPLE__)
+        if (base != nullptr && copy.empty()) munmap((void*)base, size);
+#endif
+        base = nullptr;
+        size = 0;
+        copy.clear();
+        contents = PlayLogView();
+    }
+
+public:
+    MappedPlayLog() = default;
+    MappedPlayLog(const MappedPlayLog&) = delete;
+    MappedPlayLog& operator=(const MappedPlayLog&) = delete;
+    ~MappedPlayLog() { close(); }
+
+    // False if the file can't be read or was saved compressed (PlayLog::load reads those)
+    bool open(const std::string& path) {
+        close();
+#if defined(__unix__) || defined(__APPLE__)
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        struct stat info;
+        if (fstat(fd, &info) == 0 && info.st_size > 0) {
+            void* mapped = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapped != MAP_FAILED) {
+                base = static_cast<const uint8_t*>(mapped);
+                size = info.st_size;
+            }
+        }
+        ::close(fd);
+#else
+        FILE* file = std::fopen(path.c_str(), "rb");
+        if (file == nullptr) return false;
+        uint8_t buffer[1 << 16];
+        for (size_t n; (n = std::fread(buffer, 1, sizeof(buffer), file)) > 0;) copy.insert(copy.end(), buffer, buffer + n);
+        std::fclose(file);
+        base = copy.data();
+        size = copy.size();
+#endif
+        PlayLog::FileHeader header;
+        if (base == nullptr || !PlayLog::readLayout(base, size, header, schoolNames) || header.compressed) {
+            close();
+            return false;
+        }
+        contents.schoolNames = &schoolNames;
+        contents.games = reinterpret_cast<const LoggedGame*>(base + header.gamesOffset);
+        contents.numGames = header.numGames;
+        contents.plays = reinterpret_cast<const PlayRecord*>(base + header.playsOffset);
+        contents.numPlays = header.numPlays;
+        return true;
+    }
+
+    PlayLogView view() const { return contents; }
+};
+
+// How a school's offense did in the situations a box score can't show
+struct SituationalSplits {
+    int drives = 0;
+    int plays = 0;
+    int thirdDowns = 0;
+    int thirdDownConversions = 0;
+    int fourthDowns = 0; // Only the ones the offense went for
+    int fourthDownConversions = 0;
+    int redZoneTrips = 0; // Drives that got to the 20
+    int redZoneTouchdowns = 0;
+    int redZoneFieldGoals = 0;
+
+    double thirdDownRate() const { return thirdDowns > 0 ? (double)thirdDownConversions / thirdDowns : 0; }
+    double redZoneTouchdownRate() const { return redZoneTrips > 0 ? (double)redZoneTouchdowns / redZoneTrips : 0; }
+};
+
+// Every school's offensive splits, indexed by school id, from one pass over the log
+std::vector<SituationalSplits> situationalSplits(const PlayLogView& log) {
+    std::vector<SituationalSplits> splits(log.schoolNames->size());
+    for (size_t g = 0; g < log.numGames; g++) {
+        const LoggedGame& game = log.games[g];
+        SituationalSplits* sides[2] = { &splits[game.away], &splits[game.home] };
+        bool inRedZone = false; // Whether the current drive has already been counted as a trip
+        for (const PlayRecord* p = log.begin(game); p != log.end(game); p++) {
+            SituationalSplits& s = *sides[p->homeOffense];
+            if (p->driveStart) {
+                s.drives++;
+                inRedZone = false;
+            }
+            s.plays++;
+            if (p->yardLine <= 20 && !inRedZone) {
+                s.redZoneTrips++;
+                inRedZone = true;
+            }
+            if (inRedZone && p->touchdown) s.redZoneTouchdowns++;
+            if (inRedZone && p->outcome == FIELD_GOAL_SCORED) s.redZoneFieldGoals++;
+            if (!p->isScrimmage()) continue;
+            if (p->down == 3) {
+                s.thirdDowns++;
+                s.thirdDownConversions += p->converted();
+            }
+            if (p->down == 4) {
+                s.fourthDowns++;
+                s.fourthDownConversions += p->converted();
+            }
+        }
+    }
+    return splits;
+}
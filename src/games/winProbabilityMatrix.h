@@ -0,0 +1,117 @@
+#pragma once
+
+#include "matchupSimulator.h"
+
+#include <unordered_map>
+
+/**
+ * The chance the away team wins, for any pair of schools. Each entry comes from replaying the game with the full engine
+ * and stays cached until either school's lineup changes: its depth chart, an injury, an OVR or a gametime bonus. Lineups
+ * are re-read by refresh(), which the league calls whenever they can have changed, so a lookup between refreshes is just
+ * an array read unless the entry has never been worked out.
+ */
+class WinProbabilityMatrix {
+    struct Entry {
+        bool computed = false;
+        size_t awayLineup = 0;
+        size_t homeLineup = 0;
+        double awayWinChance = 0.5; // A tie counts as half a win
+    };
+
+    int gamesPerEntry;
+    double maxIntervalWidth;
+    unsigned seed;
+    std::vector<School*> schools;
+    std::unordered_map<School*, int> schoolIndex;
+    std::vector<size_t> lineups; // Each school's lineup as of the last refresh
+    std::vector<Entry> entries;  // Away school's row, home school's column
+    std::atomic<int> gamesPlayed{ 0 };
+
+    Entry& at(int away, int home) { return entries[away * schools.size() + home]; }
+
+    bool isFresh(int away, int home) {
+        const Entry& e = at(away, home);
+        return e.computed && e.awayLineup == lineups[away] && e.homeLineup == lineups[home];
+    }
+
+    // One replay series per entry, on this thread, seeded by the pair so the same lineups always get the same games
+    void compute(int away, int home) {
+        unsigned pairSeed = seed + (unsigned)(away * schools.size() + home) * 2654435761u;
+        MatchupOdds odds = MatchupSimulator(schools[away], schools[home], 1).run(gamesPerEntry, maxIntervalWidth, pairSeed);
+        Entry& e = at(away, home);
+        e.awayWinChance = (odds.awayWins + 0.5 * odds.ties) / odds.games;
+        e.awayLineup = lineups[away];
+        e.homeLineup = lineups[home];
+        e.computed = true;
+        gamesPlayed += odds.games;
+    }
+
+public:
+    // Each entry plays up to gamesPerEntry games, or fewer once the away team's interval is narrower than maxIntervalWidth
+    WinProbabilityMatrix(int games = 200, double intervalWidth = 0, unsigned rngSeed = 1)
+        : gamesPerEntry(games), maxIntervalWidth(intervalWidth), seed(rngSeed) {}
+
+    void reset(const std::vector<School*>& allSchools) {
+        schools = allSchools;
+        schoolIndex.clear();
+        for (int i = 0; i < (int)schools.size(); i++) schoolIndex[schools[i]] = i;
+        entries.assign(schools.size() * schools.size(), Entry());
+        lineups.assign(schools.size(), 0);
+        refresh();
+    }
+
+    // Re-reads every school's lineup. Returns how many changed, and every entry involving one of them goes stale.
+    int refresh() {
+        int changed = 0;
+        for (int i = 0; i < (int)schools.size(); i++) {
+            size_t lineup = schools[i]->getRoster()->lineupFingerprint();
+            if (lineup != lineups[i]) changed++;
+            lineups[i] = lineup;
+        }
+        return changed;
+    }
+
+    // For changes a lineup can't see, like a new coaching staff
+    void invalidate(School* school) {
+        int s = schoolIndex.at(school);
+        for (int other = 0; other < (int)schools.size(); other++) {
+            at(s, other).computed = false;
+            at(other, s).computed = false;
+        }
+    }
+
+    bool isFresh(School* away, School* home) { return isFresh(schoolIndex.at(away), schoolIndex.at(home)); }
+
+    double awayWinChance(School* away, School* home) {
+        int a = schoolIndex.at(away);
+        int h = schoolIndex.at(home);
+        if (!isFresh(a, h)) compute(a, h);
+        return at(a, h).awayWinChance;
+    }
+
+    // Works out every stale entry among these (away, home) pairs, spread over every core
+    void precompute(const std::vector<std::pair<School*, School*>>& pairs) {
+        std::vector<std::pair<int, int>> stale;
+        std::vector<bool> queued(entries.size(), false);
+        for (auto& [away, home] : pairs) {
+            int a = schoolIndex.at(away);
+            int h = schoolIndex.at(home);
+            if (isFresh(a, h) || queued[a * schools.size() + h]) continue;
+            queued[a * schools.size() + h] = true;
+            stale.emplace_back(a, h);
+        }
+        parallelFor(stale.size(), [&](int i) { compute(stale[i].first, stale[i].second); });
+    }
+
+    void precomputeAll() {
+        std::vector<std::pair<School*, School*>> pairs;
+        for (School* away : schools) {
+            for (School* home : schools) {
+                if (away != home) pairs.emplace_back(away, home);
+            }
+        }
+        precompute(pairs);
+    }
+
+    int getGamesPlayed() { return gamesPlayed; }
+};
@@ -3,40 +3,38 @@
 #include "../coaches/coachesOrg.h"
 #include "../loadData.h"
 #include "../recruits/recruitLounge.h"
+#include "../games/fastGamePlayer.h"
 #include "../games/gamePlayer.h"
+#include "../games/matchupSimulator.h"
+#include "../games/winProbabilityMatrix.h"
+#include "playoffProjector.h"
 #include "schoolRanker.h"
+#include "seasonTable.h"
 #include "scheduler.h"
 
 struct SortByPrestige {
 	bool operator()(School* a, School* b) { return (a->getPrestige() > b->getPrestige()); }
 };
 
-struct SortByOffense {
-	bool operator()(School* a, School* b) { return (a->getAverageOffenseDefense().first > b->getAverageOffenseDefense().first); }
-};
-
-struct SortByDefense {
-	bool operator()(School* a, School* b) { return (a->getAverageOffenseDefense().second < b->getAverageOffenseDefense().second); }
-};
-
-struct SortByConferenceRecord {
-	bool operator()(School* a, School* b) {
-		for (bool v : { true, false }) {
-			std::pair<int, int> r1 = a->getWinLossRecord(v);
-			std::pair<int, int> r2 = b->getWinLossRecord(v);
-			if (r1.first > r2.first) return true;
-			if (r1.first < r2.first) return false;
-			if (r1.second < r2.second) return true;
-			if (r1.second > r2.second) return false;
-
-			if (v) {
-				// Check the direct matchup between schools
-				if (a->didIWinAgainst(b)) return true;
-				if (b->didIWinAgainst(a)) return false;
-			}
-		}
-		// shrug
-		return (a->getRankingScore() > b->getRankingScore());
+// Wall-clock milliseconds spent in each stage of an offseason
+struct OffseasonTimings {
+	double contractDecisions = 0;
+	double coachingCarousel = 0;
+	double playerDevelopment = 0;
+	double recruiting = 0;
+	double seasonSetup = 0;
+	long long recruitPairsSearched = 0; // (recruit, school) pairs looked at on signing day
+	long long recruitPairsScored = 0;   // The ones that needed their full score
+
+	double total() const { return contractDecisions + coachingCarousel + playerDevelopment + recruiting + seasonSetup; }
+
+	void print() const {
+		printf("Contract decisions: %12.1f ms\n", contractDecisions);
+		printf("Coaching carousel: %13.1f ms\n", coachingCarousel);
+		printf("Player development: %12.1f ms\n", playerDevelopment);
+		printf("Recruiting: %20.1f ms (%lld of %lld pairs scored)\n", recruiting, recruitPairsScored, recruitPairsSearched);
+		printf("Season setup: %18.1f ms\n", seasonSetup);
+		printf("Total: %25.1f ms\n", total());
 	}
 };
 
@@ -46,16 +44,26 @@ private:
 	std::vector<School*> allSchools;
 
 	SchoolRanker schoolRanker;
+	SeasonTable seasonTable; // Rebuilt every week
+	BackgroundTask weekSummary; // The standings and poll after the latest week, worked out while the next one plays
+	WinProbabilityMatrix winProbabilities; // Refreshed whenever lineups can have changed
 
 	Scheduler scheduler;
 
 	CoachesOrganization coachesOrg;
 
 	TopRecruitingClass latestTRC;
+	RecruitingMode recruitingMode = RecruitingMode::GREEDY;
+
+	GameEngine gameEngine = GameEngine::PLAY_BY_PLAY;
+	FastSimModel fastSimModel = FastSimModel::defaults();
+	PlayLog playLog; // Every snap of this season's play-by-play games
 
 	int year = 2020;
 	int week = 0;
 
+	OffseasonTimings lastOffseasonTimings;
+
 	void assembleSchoolVector() {
 		for (int i = 0; i < (int)conferences.size(); ++i) {
 			for (auto& school : conferences[i]) { school.setDivision((Conference)i); }
@@ -91,24 +99,56 @@ private:
 		std::vector<School::Matchup*> weekLineup = scheduler.getWeek(week);
 		for (auto& matchup : weekLineup) {
 			if (matchup->gameResult.homeStats != nullptr) continue;
-			GamePlayer game(matchup->away, matchup->home);
-			GameResult result = game.startRealTimeGameLoop(false);
-			matchup->gameResult = result;
+			if (gameEngine == GameEngine::FAST) {
+				matchup->gameResult = FastGamePlayer(matchup->away, matchup->home, fastSimModel).play();
+				continue;
+			}
+			playRecordedGame(matchup, false);
 		}
 		std::cout << "done." << std::endl;
 		week++;
 		performNewWeekTasks(week);
 	}
 
+	/**
+	 * Plays a matchup on snapshots of the real rosters. If it's the first time, the result counts: its injuries are applied
+	 * to the real players, its snaps go in the play log, and the seed and both rosters at kickoff are kept so that
+	 * replayGame can play the same game again. Otherwise the teams are left as they were.
+	 */
+	GameResult playRecordedGame(School::Matchup* matchup, bool playByPlay) {
+		RosterState awayKickoff = matchup->away->getRoster()->saveState();
+		RosterState homeKickoff = matchup->home->getRoster()->saveState();
+		unsigned seed = RNG::gen();
+		std::vector<PlayRecord> snaps;
+		GamePlayer game(matchup->away, matchup->home);
+		game.logPlaysTo(&snaps);
+		GameResult result = game.startSeededGameLoop(seed, playByPlay);
+		if (matchup->gameResult.awayStats != nullptr) return result;
+		matchup->away->getRoster()->applyInjuries(result.awayInjuries);
+		matchup->home->getRoster()->applyInjuries(result.homeInjuries);
+		matchup->gameResult = result;
+		matchup->replayable = true;
+		matchup->seed = seed;
+		matchup->awayKickoff = std::move(awayKickoff);
+		matchup->homeKickoff = std::move(homeKickoff);
+		playLog.addGame(week, matchup->away->getName(), matchup->home->getName(), snaps, result.awayStats->points, result.homeStats->points);
+		return result;
+	}
+
+	/**
+	 * Rosters have to be caught up before the next week kicks off, but nothing in a game looks at the standings or the
+	 * poll, so those are summarized in the background while the next week plays. The postseason is picked from them, so
+	 * from week 13 on the summary is waited for before anything gets scheduled.
+	 */
 	void performNewWeekTasks(int newWeek) {
 		for (auto school : allSchools) {
 			school->getRoster()->advanceOneWeek();
 		}
-		schoolRanker.rankTeams(newWeek);
-		if (newWeek == 13) {
-			scheduler.scheduleConferenceChampionshipGames();
-			assignOffenseDefenseRankings();
-		}
+		winProbabilities.refresh();
+		weekSummary.start([this, newWeek]() { summarizeWeek(newWeek); });
+		if (newWeek < 13) return;
+		weekSummary.wait();
+		if (newWeek == 13) scheduler.scheduleConferenceChampionshipGames();
 		if (newWeek == 14) scheduler.schedulePlayoffs();
 		if (newWeek == 15) scheduler.scheduleFinals();
 		if (newWeek == 16) {
@@ -117,22 +157,28 @@ private:
 		}
 	}
 
+	// Standings, poll, and once the regular season's over the offense and defense rankings. Reads only the games before
+	// newWeek, and writes nothing a game reads.
+	void summarizeWeek(int newWeek) {
+		seasonTable.rebuild(allSchools, newWeek);
+		schoolRanker.rankTeams(newWeek);
+		if (newWeek == 13) assignOffenseDefenseRankings();
+	}
+
 	GameResult playOneGame(int matchupIndex, bool silent) {
-		School::Matchup* matchup = scheduler.getWeek(week)[matchupIndex];
-		GamePlayer game(matchup->away, matchup->home);
-		GameResult result = game.startRealTimeGameLoop(!silent);
-		if (matchup->gameResult.awayStats == nullptr) matchup->gameResult = result;
-		return result;
+		return playRecordedGame(scheduler.getWeek(week)[matchupIndex], !silent);
 	}
 
 	void assignOffenseDefenseRankings() {
-		std::vector<School*> sortedSchools = allSchools;
-		SortByOffense sbo;
-		std::sort(sortedSchools.begin(), sortedSchools.end(), sbo);
-		for (int i = 0; i < (int)sortedSchools.size(); i++) { sortedSchools[i]->setOffenseRanking(i + 1); }
-		SortByDefense sbd;
-		std::sort(sortedSchools.begin(), sortedSchools.end(), sbd);
-		for (int i = 0; i < (int)sortedSchools.size(); i++) { sortedSchools[i]->setDefenseRanking(i + 1); }
+		std::vector<double> offense, defense;
+		for (int i = 0; i < seasonTable.size(); i++) {
+			offense.push_back(seasonTable[i].averageOffense);
+			defense.push_back(seasonTable[i].averageDefense);
+		}
+		std::vector<int> byOffense = sortedOrder(offense, std::greater<double>());
+		for (int i = 0; i < (int)byOffense.size(); i++) seasonTable[byOffense[i]].school->setOffenseRanking(i + 1);
+		std::vector<int> byDefense = sortedOrder(defense, std::less<double>());
+		for (int i = 0; i < (int)byDefense.size(); i++) seasonTable[byDefense[i]].school->setDefenseRanking(i + 1);
 	}
 
 	void assignOffenseDefenseOvrs() {
@@ -189,6 +235,8 @@ private:
 			school->applyGametimeBonuses();
 		}
 		schoolRanker.resetPoll(allSchools);
+		seasonTable.rebuild(allSchools);
+		winProbabilities.refresh();
 		assignOffenseDefenseOvrs();
 	}
 
@@ -260,11 +308,43 @@ public:
 		return school->getMyStats(week);
 	}
 
+	// Tells one of a school's games from this season again, play by play. Returns false if there's no such game to tell.
+	bool printPlayByPlay(std::string schoolName, int week) {
+		School* school = findSchoolByName(schoolName);
+		if (school == nullptr) return false;
+		School::Matchup* matchup = school->getGameResults(week);
+		if (matchup == nullptr || matchup->gameResult.homeStats == nullptr) {
+			std::cout << "No game was played that week." << std::endl;
+			return false;
+		}
+		if (!matchup->replayable) {
+			std::cout << "That game went through the fast engine, which doesn't play it snap by snap." << std::endl;
+			return false;
+		}
+		GameResult result = replayGame(matchup, true);
+		delete result.awayStats;
+		delete result.homeStats;
+		return true;
+	}
+
+	/**
+	 * Plays a finished game again from its seed, on snapshots of both rosters put back the way they were at kickoff, so it
+	 * comes out exactly as it did. Its injuries are left in the result and never applied. The caller owns the returned stats.
+	 */
+	GameResult replayGame(School::Matchup* matchup, bool playByPlay) {
+		assert(matchup->replayable);
+		TeamSnapshot awaySnapshot(matchup->away->getRoster(), &matchup->awayKickoff);
+		TeamSnapshot homeSnapshot(matchup->home->getRoster(), &matchup->homeKickoff);
+		GamePlayer game(matchup->away, matchup->home, &awaySnapshot, &homeSnapshot, new TeamStats(), new TeamStats());
+		return game.startSeededGameLoop(matchup->seed, playByPlay);
+	}
+
 	TeamStats* getSchoolAggregatedStats(std::string schoolName) {
 		School* school = findSchoolByName(schoolName);
 		if (school == nullptr) return nullptr;
 		TeamStats* aggregate = new TeamStats; // IT IS THE DRIVER'S RESPONSIBILITY TO DELETE THIS
 		aggregate->games = 0;
+		aggregate->roster = school->getRoster();
 		for (int i = 0; i < 16; i++) {
 			School::Matchup* m = school->getGameResults(i);
 			if (m != nullptr && m->gameResult.homeStats != nullptr) {
@@ -279,8 +359,11 @@ public:
 	}
 
 	bool printGamePlayerStats(TeamStats* stats, int player) {
-		if (player >= (int)(stats->getPlayersRecorded().size())) return false;
-		stats->printPlayerStats(stats->getPlayersRecorded()[player]);
+		std::vector<PlayerHandle> recorded = stats->getPlayersRecorded();
+		if (player >= (int)recorded.size()) return false;
+		Player* p = stats->roster->getPlayer(recorded[player]);
+		if (p == nullptr) std::cout << "That player is no longer on the roster.\n";
+		else stats->printPlayerStats(p);
 		return true;
 	}
 
@@ -292,15 +375,15 @@ public:
 		for (Conference division : { divisions.first, divisions.second }) {
 			std::cout << "\n" << divisionName(division) << "\n";
 			std::cout << "===========================================\n";
-			std::vector<School*> schools;
-			for (School& s : conferences[division]) { schools.push_back(&s); }
-			SortByConferenceRecord sbcr;
-			std::sort(schools.begin(), schools.end(), sbcr);
-			for (int i = 0; i < (int)schools.size(); i++) {
-				std::pair<int, int> rec = schools[i]->getWinLossRecord(false);
-				std::pair<int, int> cRec = schools[i]->getWinLossRecord(true);
+			std::vector<int> rowIds;
+			for (School& s : conferences[division]) rowIds.push_back(seasonTable.getRowId(&s));
+			std::vector<int> standings = seasonTable.standingsOrder(rowIds);
+			for (int i = 0; i < (int)standings.size(); i++) {
+				const SeasonRow& row = seasonTable[standings[i]];
+				std::pair<int, int> rec = row.record;
+				std::pair<int, int> cRec = row.conferenceRecord;
 				std::string wlstr = std::to_string(rec.first) + " - " + std::to_string(rec.second);
-				printf("%2d) %-25s%-7s(%d - %d)\n", i + 1, schools[i]->getRankedName().c_str(), wlstr.c_str(), cRec.first, cRec.second);
+				printf("%2d) %-25s%-7s(%d - %d)\n", i + 1, row.school->getRankedName().c_str(), wlstr.c_str(), cRec.first, cRec.second);
 			}
 			if (divisions.first == divisions.second) return;
 		}
@@ -356,8 +439,10 @@ public:
 			 *  1) Jaylen Edwards       Athens, MI        LB 80 OVR
 			 *     School: Ohio State         Top Priority: Academics
 			 */
+			if (latestTRC.schoolChoices[i] == nullptr) continue; // Went unsigned
 			Recruit& r = latestTRC.recruits[i];
-			Player* p = r.getUnderlyingPlayer();
+			Player* p = latestTRC.schoolChoices[i]->getRoster()->getPlayer(latestTRC.players[i]);
+			if (p == nullptr) continue;
 			printf("%2d) %-20s %-20s %-2s %-2d OVR\n", i + 1, p->getName().c_str(), p->getHometown()->formalName().c_str(), positionToStr(p->getPosition()).c_str(), p->getOVR());
 			printf("    School: %-12s Top Priority: %s\n\n", latestTRC.schoolChoices[i]->getName().c_str(), r.getTopPreferenceStr().c_str());
 		}
@@ -367,7 +452,11 @@ public:
 		playEntireSchedule();
 	}
 
-	void simOneWeek() { playOneWeek(); }
+	// Waits for the week's summary, so the standings and poll are up to date for whoever looks next
+	void simOneWeek() {
+		playOneWeek();
+		weekSummary.wait();
+	}
 
 	bool simOneGame(int gameIndex, bool replay) {
 		if (scheduler.getWeek(week)[gameIndex - 1]->gameResult.homeStats != nullptr && !replay) {
@@ -393,62 +482,102 @@ public:
 		return true;
 	}
 
-	void simOneGameRepeatedly(int gameIndex, int numTimes) {
-		std::cout << "Simulating";
-		GameResult collectiveResult;
-		int homeWins = 0;
-		int awayWins = 0;
-		for (int i = 0; i < numTimes; i++) {
-			if (i % 10 == 0) {
-				std::cout << ".";
-				std::cout.flush();
-			}
-			GameResult result = playOneGame(gameIndex - 1, true);
-			if (!result.awayWon && !result.homeWon) {
-				i--;
-				continue;
-			}
-			if (result.awayWon) awayWins++;
-			else
-				homeWins++;
-			if (collectiveResult.awayStats == nullptr) collectiveResult = result;
-			else
-				collectiveResult += result;
-		}
-		std::cout << " done." << std::endl;
-		std::cout << "\nAway - home wins: " << awayWins << " - " << homeWins << "\n";
-		printf("Away won %.1f%% of the time\n\n", ((double)awayWins / numTimes) * 100.0);
-		std::cout << "AWAY STATS:\n";
-		collectiveResult.awayStats->printBigStuff();
-		std::cout << "\nHOME STATS:\n";
-		collectiveResult.homeStats->printBigStuff();
+	// Replays a game from this week on copies of both teams, so neither the result nor any injuries count. Stops early
+	// once the away team's win chance is known to within maxIntervalWidth, if that's above 0.
+	void simOneGameRepeatedly(int gameIndex, int numTimes, double maxIntervalWidth = 0) {
+		School::Matchup* matchup = scheduler.getWeek(week)[gameIndex - 1];
+		std::cout << "Simulating... ";
+		std::cout.flush();
+		MatchupOdds odds = MatchupSimulator(matchup->away, matchup->home).run(numTimes, maxIntervalWidth, std::random_device()());
+		std::cout << "done." << std::endl;
+		odds.print(matchup->away, matchup->home);
 	}
 
-	void simOneGameRepeatedly(std::string schoolName, int numTimes) {
+	void simOneGameRepeatedly(std::string schoolName, int numTimes, double maxIntervalWidth = 0) {
 		int i = 0;
 		for (auto& matchup : scheduler.getWeek(week)) {
-			if (matchup->away->getName() == schoolName || matchup->home->getName() == schoolName) { simOneGameRepeatedly(i + 1, numTimes); }
+			if (matchup->away->getName() == schoolName || matchup->home->getName() == schoolName) {
+				simOneGameRepeatedly(i + 1, numTimes, maxIntervalWidth);
+			}
 			i++;
 		}
 	}
 
+	// Plays out the rest of the season from where it stands, without changing anything in the league
+	// With lockstepGamesPerMatchup above 0, each remaining scheduled game's margin comes from that many lockstep games
+	PlayoffOdds projectPlayoffOdds(int maxSimulations = 10000, double maxIntervalWidth = 0.02, unsigned seed = std::random_device()(),
+		int lockstepGamesPerMatchup = 0) {
+		std::vector<std::vector<School::Matchup*>> schedule;
+		for (int w = 0; w < 16; w++) schedule.push_back(scheduler.getWeek(w));
+		PlayoffProjector projector(conferences, schedule, week);
+		if (lockstepGamesPerMatchup > 0) projector.useLockstepMargins(lockstepGamesPerMatchup, seed);
+		return projector.project(maxSimulations, maxIntervalWidth, seed);
+	}
+
 	void prepareNextSeason() {
+		OffseasonTimings timings;
+		auto start = std::chrono::steady_clock::now();
 		makeCoachContractDecisions();
 		coachesOrg.advanceYear();
+		timings.contractDecisions = elapsedMs(start);
+
+		start = std::chrono::steady_clock::now();
 		coachesOrg.fillAllVacancies(allSchools);
+		timings.coachingCarousel = elapsedMs(start);
 
-		for (School* school : allSchools) school->prepareNextSeason();
+		start = std::chrono::steady_clock::now();
+		// Schools' offseasons (graduation and player development) don't touch each other, so run them side by side
+		parallelFor(allSchools.size(), [this](int i) { allSchools[i]->prepareNextSeason(); });
+		timings.playerDevelopment = elapsedMs(start);
+
+		start = std::chrono::steady_clock::now();
 		RecruitLounge recruits;
+		recruits.setRecruitingMode(recruitingMode);
 		recruits.generateNewRecruitingClass();
 		latestTRC = recruits.signRecruitingClass(allSchools);
+		timings.recruiting = elapsedMs(start);
+		timings.recruitPairsSearched = recruits.getSchoolIndex().getSearchedCount();
+		timings.recruitPairsScored = recruits.getSchoolIndex().getEvaluatedCount();
 
 		year++;
 		week = 0;
+		playLog.clear();
 
+		start = std::chrono::steady_clock::now();
 		sortSchoolVectorByPrestige();
 		initializeSeason();
+		timings.seasonSetup = elapsedMs(start);
+		lastOffseasonTimings = timings;
+	}
+
+	// Both take effect from the next offseason
+	void setHiringMode(HiringMode mode) { coachesOrg.setHiringMode(mode); }
+	void setRecruitingMode(RecruitingMode mode) { recruitingMode = mode; }
+	// Takes effect from the next weekly ranking
+	void setRankingAlgorithm(RankingAlgorithm algorithm) { schoolRanker.setAlgorithm(algorithm); }
+	// Takes effect from the next simulated week. Games played one at a time always use the play-by-play engine.
+	void setGameEngine(GameEngine engine) { gameEngine = engine; }
+
+	// Refits the fast engine to this league's rosters as they are now, from games between random pairs of schools
+	const FastSimModel& calibrateFastSim(int games, unsigned seed) {
+		std::mt19937 rng(seed);
+		std::uniform_int_distribution<int> pick(0, allSchools.size() - 1);
+		std::vector<std::pair<School*, School*>> pairs;
+		while ((int)pairs.size() < games) {
+			School* away = allSchools[pick(rng)];
+			School* home = allSchools[pick(rng)];
+			if (away != home) pairs.emplace_back(away, home);
+		}
+		fastSimModel = FastSimModel::fit(FastSimModel::sampleFullEngine(pairs, seed));
+		return fastSimModel;
 	}
 
+	const OffseasonTimings& getLastOffseasonTimings() { return lastOffseasonTimings; }
+
+	const std::vector<School*>& getAllSchools() { return allSchools; }
+	WinProbabilityMatrix& getWinProbabilities() { return winProbabilities; }
+	// Fast-engine games have no snaps, so only play-by-play games show up here
+	const PlayLog& getPlayLog() { return playLog; }
 	int getCurrentWeek() { return week + 1; }
 	int getCurrentYear() { return year; }
 
@@ -474,13 +603,15 @@ public:
 
 		// Let's do a proper initialization
 		for (int i = 0; i < 4; i++) {
-			for (auto& school : allSchools) school->advanceRosterOneYear();
+			parallelFor(allSchools.size(), [this](int i) { allSchools[i]->advanceRosterOneYear(); });
 			RecruitLounge recruits;
+			recruits.setRecruitingMode(recruitingMode);
 			recruits.generateNewRecruitingClass();
 			latestTRC = recruits.signRecruitingClass(allSchools);
 		}
 
 		scheduler.setSchools(&conferences, allSchools);
+		winProbabilities.reset(allSchools);
 		initializeSeason();
 	}
 };
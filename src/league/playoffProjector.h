@@ -0,0 +1,317 @@
+#pragma once
+#include "scheduler.h"
+#include "schoolRanker.h"
+#include "../games/lockstepGames.h"
+
+#include <array>
+#include <random>
+#include <unordered_map>
+
+// How often each school got there over a batch of projected seasons
+struct PlayoffOdds {
+    std::vector<School*> schools;
+    std::vector<int> championshipGames; // Made their conference championship game
+    std::vector<int> playoffs;
+    std::vector<int> titles;
+    int simulations = 0;
+
+    void resize(int n) {
+        championshipGames.assign(n, 0);
+        playoffs.assign(n, 0);
+        titles.assign(n, 0);
+    }
+
+    void add(const PlayoffOdds& other) {
+        for (int i = 0; i < (int)playoffs.size(); i++) {
+            championshipGames[i] += other.championshipGames[i];
+            playoffs[i] += other.playoffs[i];
+            titles[i] += other.titles[i];
+        }
+        simulations += other.simulations;
+    }
+
+    // The widest playoff or title interval of any school
+    double widestInterval() const {
+        double widest = 0;
+        for (int i = 0; i < (int)playoffs.size(); i++) {
+            for (int hits : { playoffs[i], titles[i] }) {
+                std::pair<double, double> ci = wilsonInterval(hits, simulations);
+                widest = std::max(widest, ci.second - ci.first);
+            }
+        }
+        return widest;
+    }
+
+    void print(int count = 25) const {
+        std::vector<double> keys;
+        for (int i = 0; i < (int)playoffs.size(); i++) keys.push_back(playoffs[i] + titles[i] / (simulations + 1.0));
+        std::vector<int> order = sortedOrder(keys, std::greater<double>());
+        printf("Playoff odds over %d simulations of the rest of the season (95%% intervals)\n", simulations);
+        std::cout << "School                     CCG      Playoff             Title\n";
+        std::cout << "----------------------------------------------------------------------\n";
+        for (int i = 0; i < count && i < (int)order.size(); i++) {
+            int s = order[i];
+            std::pair<double, double> p = wilsonInterval(playoffs[s], simulations);
+            std::pair<double, double> t = wilsonInterval(titles[s], simulations);
+            printf("%-25s %5.1f%%  %5.1f%% (%4.1f-%4.1f)  %5.1f%% (%4.1f-%4.1f)\n", schools[s]->getRankedName().c_str(),
+                100.0 * championshipGames[s] / simulations, 100.0 * playoffs[s] / simulations, 100 * p.first, 100 * p.second,
+                100.0 * titles[s] / simulations, 100 * t.first, 100 * t.second);
+        }
+    }
+};
+
+/**
+ * Plays out the rest of a season many times over from a snapshot of the league, so nothing in the league changes. The
+ * play-by-play engine is far too slow for thousands of seasons, so each game is just a point margin drawn around the
+ * difference in the two schools' actual OVRs. The poll, the conference championship tiebreakers and the playoff picks
+ * are the same code the league uses. Projected rankings always follow the poll, whatever algorithm the league ranks by.
+ */
+class PlayoffProjector {
+public:
+    // Fit to 4,000 play-by-play games between random pairs of schools in a fresh league, where home field came out at a
+    // fifth of a point (seed 1, see benchPlayoffOdds)
+    static constexpr double POINTS_PER_OVR = 0.86;
+    static constexpr double MARGIN_STDEV = 16.8;
+
+    // A school's strength for the margin model: its offense and defense OVRs added up
+    static int strengthOf(School* school) {
+        std::pair<int, int> ovrs = school->getActualOvrs();
+        return ovrs.first + ovrs.second;
+    }
+
+private:
+    static constexpr int SIMULATIONS_PER_CHUNK = 50;
+    static constexpr int CHUNKS_PER_BATCH = 20;
+    static constexpr int PASS_SAMPLES = 300; // For lockstep margins
+
+    struct Game {
+        int away;
+        int home;
+        bool conference;
+        bool played;
+        int margin; // Away points minus home points, if played
+        double expectedMargin;
+        double marginStdev;
+    };
+
+    // Everything about the season so far that the rest of it depends on
+    struct SeasonState {
+        std::vector<double> pollScore;
+        std::vector<int> ranking;
+        std::vector<int> byRanking; // Best first
+        std::vector<int> conferenceWins;
+        std::vector<std::array<signed char, 13>> beat; // 1 if they beat that week's opponent
+    };
+
+    std::vector<School*> teams;
+    std::unordered_map<School*, int> teamIndex;
+    std::vector<int> strength;
+    std::vector<std::array<int, 13>> opponents; // -1 for a bye
+    std::vector<std::vector<int>> divisions;    // Indexed by Conference, in the league's order
+    std::vector<std::vector<Game>> weeks;       // Every scheduled game from firstWeek on, played or not
+    int firstWeek;
+    SeasonState start;
+
+    static void recordGame(SeasonState& state, int week, const Game& g, int margin) {
+        if (week >= 13) return;
+        state.beat[g.away][week] = margin > 0;
+        state.beat[g.home][week] = margin < 0;
+        if (g.conference) state.conferenceWins[margin > 0 ? g.away : g.home]++; // A tie counts as a home win
+    }
+
+    static void updatePoll(SeasonState& state, const std::vector<Game>& games, const std::vector<int>& margins) {
+        for (int i = 0; i < (int)games.size(); i++) {
+            const Game& g = games[i];
+            double away = updatedPollScore(state.pollScore[g.away], state.ranking[g.away], state.ranking[g.home], margins[i]);
+            double home = updatedPollScore(state.pollScore[g.home], state.ranking[g.home], state.ranking[g.away], -margins[i]);
+            state.pollScore[g.away] = away;
+            state.pollScore[g.home] = home;
+        }
+        std::vector<int> lastWeek = state.byRanking;
+        std::vector<double> scores;
+        for (int team : lastWeek) scores.push_back(state.pollScore[team]);
+        std::vector<int> order = sortedOrder(scores, std::greater<double>());
+        for (int i = 0; i < (int)order.size(); i++) {
+            state.byRanking[i] = lastWeek[order[i]];
+            state.ranking[state.byRanking[i]] = i + 1;
+        }
+    }
+
+    Game makeGame(int away, int home) {
+        School* a = teams[away];
+        School* h = teams[home];
+        return Game{ away, home, areSameConference(a->getDivision(), h->getDivision()), false, 0,
+            POINTS_PER_OVR * (strength[away] - strength[home]), MARGIN_STDEV };
+    }
+
+    std::vector<Game> championshipGames(const SeasonState& state, std::mt19937& rng) {
+        std::vector<Game> games;
+        for (std::pair<Conference, Conference> pair : CHAMPIONSHIP_GAME_DIVISIONS) {
+            int representatives[2];
+            int i = 0;
+            for (Conference conf : { pair.first, pair.second }) {
+                std::vector<int> tied = divisionTiebreak(divisions[conf], [&](int t) { return state.conferenceWins[t]; }, [&](int a, int b) {
+                    for (int week = 0; week < 13; week++) {
+                        if (opponents[a][week] == b) return state.beat[a][week] == 1;
+                    }
+                    return false;
+                });
+                representatives[i++] = *select_randomly(tied.begin(), tied.end(), rng);
+            }
+            games.push_back(makeGame(representatives[0], representatives[1]));
+        }
+        return games;
+    }
+
+    // A tie sends the away team through, as it does in the league
+    static int winner(const Game& g, int margin) { return margin >= 0 ? g.away : g.home; }
+
+    static int drawMargin(const Game& g, std::mt19937& rng) {
+        std::normal_distribution<double> margin(g.expectedMargin, g.marginStdev);
+        return (int)std::lround(margin(rng));
+    }
+
+    void playRestOfSeason(SeasonState& state, PlayoffOdds& odds, std::mt19937& rng) {
+        std::vector<Game> postseason;
+        std::vector<int> margins;
+        std::vector<int> lastWeekWinners;
+        for (int week = firstWeek; week < 16; week++) {
+            const std::vector<Game>& scheduled = weeks[week - firstWeek];
+            if (week == 13 && scheduled.empty()) postseason = championshipGames(state, rng);
+            else if (week == 14 && scheduled.empty())
+                postseason = { makeGame(state.byRanking[3], state.byRanking[0]), makeGame(state.byRanking[2], state.byRanking[1]) };
+            else if (week == 15 && scheduled.empty())
+                postseason = { makeGame(lastWeekWinners[1], lastWeekWinners[0]) };
+            const std::vector<Game>& games = week >= 13 && scheduled.empty() ? postseason : scheduled;
+
+            margins.clear();
+            lastWeekWinners.clear();
+            for (const Game& g : games) {
+                int margin = g.played ? g.margin : drawMargin(g, rng);
+                recordGame(state, week, g, margin);
+                margins.push_back(margin);
+                lastWeekWinners.push_back(winner(g, margin));
+                if (week == 13) {
+                    odds.championshipGames[g.away]++;
+                    odds.championshipGames[g.home]++;
+                } else if (week == 14) {
+                    odds.playoffs[g.away]++;
+                    odds.playoffs[g.home]++;
+                } else if (week == 15)
+                    odds.titles[winner(g, margin)]++;
+            }
+            updatePoll(state, games, margins);
+        }
+        odds.simulations++;
+    }
+
+public:
+    // schedule holds all 16 weeks as the scheduler has them, and week is the league's next week to play
+    PlayoffProjector(std::vector<std::vector<School>>& conferences, const std::vector<std::vector<School::Matchup*>>& schedule, int week)
+        : firstWeek(week) {
+        divisions.resize(conferences.size());
+        for (auto& conference : conferences) {
+            for (School& school : conference) {
+                teamIndex[&school] = teams.size();
+                divisions[school.getDivision()].push_back(teams.size());
+                teams.push_back(&school);
+                strength.push_back(strengthOf(&school));
+            }
+        }
+        int n = teams.size();
+        opponents.assign(n, std::array<int, 13>());
+        start.beat.assign(n, std::array<signed char, 13>());
+        start.conferenceWins.assign(n, 0);
+        for (int t = 0; t < n; t++) {
+            opponents[t].fill(-1);
+            start.beat[t].fill(0);
+        }
+        assert(schedule.size() == 16);
+        for (int w = 0; w < 16; w++) {
+            std::vector<Game> games;
+            for (School::Matchup* m : schedule[w]) {
+                Game g = makeGame(teamIndex[m->away], teamIndex[m->home]);
+                if (w < 13) {
+                    opponents[g.away][w] = g.home;
+                    opponents[g.home][w] = g.away;
+                }
+                if (m->gameResult.homeStats != nullptr) {
+                    g.played = true;
+                    g.margin = m->gameResult.awayStats->points - m->gameResult.homeStats->points;
+                }
+                games.push_back(g);
+            }
+            if (w < firstWeek) {
+                for (const Game& g : games) {
+                    if (g.played) recordGame(start, w, g, g.margin);
+                }
+            } else
+                weeks.push_back(games);
+        }
+        for (School* school : teams) {
+            start.pollScore.push_back(school->getRankingScore());
+            start.ranking.push_back(school->getRanking());
+        }
+        start.byRanking = sortedOrder(start.ranking, std::less<int>());
+    }
+
+    /**
+     * Swaps the OVR guess for every scheduled game still to be played for the mean and spread of the margin over
+     * gamesPerMatchup lockstep games between the two rosters. Postseason matchups aren't known yet, so they keep it.
+     * Hundreds of games each have to be measured, so each side gets a quick look at its pass game.
+     */
+    void useLockstepMargins(int gamesPerMatchup, unsigned seed) {
+        std::vector<Game*> unplayed;
+        for (std::vector<Game>& games : weeks) {
+            for (Game& g : games) {
+                if (!g.played) unplayed.push_back(&g);
+            }
+        }
+        parallelFor(unplayed.size(), [&](int i) {
+            Game& g = *unplayed[i];
+            LockstepGames games(teams[g.away]->getRoster(), teams[g.home]->getRoster(), seed + i, PASS_SAMPLES);
+            int awayPoints[LockstepGames::LANES], homePoints[LockstepGames::LANES];
+            double total = 0, squares = 0;
+            int played = 0;
+            for (; played < gamesPerMatchup; played += LockstepGames::LANES) {
+                games.play(awayPoints, homePoints);
+                for (int l = 0; l < LockstepGames::LANES; l++) {
+                    double margin = awayPoints[l] - homePoints[l];
+                    total += margin;
+                    squares += margin * margin;
+                }
+            }
+            g.expectedMargin = total / played;
+            g.marginStdev = std::sqrt(std::max(1.0, squares / played - g.expectedMargin * g.expectedMargin));
+        });
+    }
+
+    /**
+     * Projects the rest of the season in batches spread over every core, and stops as soon as every school's playoff and
+     * title intervals are narrower than maxIntervalWidth. Each chunk of simulations has its own seed, so the results
+     * don't depend on how many threads there are.
+     */
+    PlayoffOdds project(int maxSimulations, double maxIntervalWidth, unsigned seed) {
+        PlayoffOdds total;
+        total.schools = teams;
+        total.resize(teams.size());
+        for (int batch = 0; total.simulations < maxSimulations; batch++) {
+            int remaining = maxSimulations - total.simulations;
+            int chunks = std::min(CHUNKS_PER_BATCH, (remaining + SIMULATIONS_PER_CHUNK - 1) / SIMULATIONS_PER_CHUNK);
+            std::vector<PlayoffOdds> results(chunks);
+            parallelFor(chunks, [&](int c) {
+                std::seed_seq seeds{ seed, (unsigned)batch, (unsigned)c };
+                std::mt19937 rng(seeds);
+                results[c].resize(teams.size());
+                int simulations = std::min(SIMULATIONS_PER_CHUNK, remaining - c * SIMULATIONS_PER_CHUNK);
+                for (int i = 0; i < simulations; i++) {
+                    SeasonState state = start;
+                    playRestOfSeason(state, results[c], rng);
+                }
+            });
+            for (const PlayoffOdds& result : results) total.add(result);
+            if (total.widestInterval() < maxIntervalWidth) break;
+        }
+        return total;
+    }
+};
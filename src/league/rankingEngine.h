@@ -0,0 +1,228 @@
+#pragma once
+#include "../school.h"
+
+#include <unordered_map>
+
+// POLL is the week-to-week poll the game has always had. ELO, MASSEY and COLLEY are computer rankings over every game
+// played so far, and BLENDED averages all four of them.
+enum class RankingAlgorithm { POLL, ELO, MASSEY, COLLEY, BLENDED };
+
+/**
+ * A symmetric positive definite matrix stored as compressed rows, solved with conjugate gradient. The Massey and Colley
+ * systems are both a diagonal minus the adjacency of the game graph, so each row only holds a dozen or so entries.
+ */
+class SparseSystem {
+    std::vector<int> rowStart;
+    std::vector<int> columns;
+    std::vector<double> values;
+
+    static double dot(const std::vector<double>& a, const std::vector<double>& b) {
+        double total = 0;
+        for (int i = 0; i < (int)a.size(); i++) total += a[i] * b[i];
+        return total;
+    }
+
+public:
+    // rows[i] holds the (column, value) entries of row i, and the whole thing must be symmetric
+    SparseSystem(const std::vector<std::vector<std::pair<int, double>>>& rows) {
+        rowStart.push_back(0);
+        for (auto& row : rows) {
+            for (auto& [column, value] : row) {
+                columns.push_back(column);
+                values.push_back(value);
+            }
+            rowStart.push_back(columns.size());
+        }
+    }
+
+    int size() const { return rowStart.size() - 1; }
+
+    void multiply(const std::vector<double>& x, std::vector<double>& out) const {
+        out.assign(size(), 0);
+        for (int i = 0; i < size(); i++) {
+            double total = 0;
+            for (int k = rowStart[i]; k < rowStart[i + 1]; k++) total += values[k] * x[columns[k]];
+            out[i] = total;
+        }
+    }
+
+    // Solves A x = b, starting from whatever is already in x. Returns how many iterations it took.
+    int solve(const std::vector<double>& b, std::vector<double>& x, double tolerance = 1e-8, int maxIterations = 1000) const {
+        int n = size();
+        x.resize(n, 0);
+        std::vector<double> r(n), p(n), ap(n);
+        multiply(x, ap);
+        for (int i = 0; i < n; i++) r[i] = b[i] - ap[i];
+        p = r;
+        double rr = dot(r, r);
+        double threshold = tolerance * tolerance * std::max(dot(b, b), 1e-300);
+        int iterations = 0;
+        while (iterations < maxIterations && rr > threshold) {
+            multiply(p, ap);
+            double alpha = rr / dot(p, ap);
+            for (int i = 0; i < n; i++) {
+                x[i] += alpha * p[i];
+                r[i] -= alpha * ap[i];
+            }
+            double rrNext = dot(r, r);
+            for (int i = 0; i < n; i++) p[i] = r[i] + (rrNext / rr) * p[i];
+            rr = rrNext;
+            iterations++;
+        }
+        return iterations;
+    }
+};
+
+/**
+ * Rates every school from the games played so far. Results are picked up a week at a time as they come in, and Elo is
+ * updated game by game as it sees them. Massey and Colley rebuild their systems from the whole game list each week, and
+ * conjugate gradient starts from last week's answer.
+ */
+class RankingEngine {
+    static constexpr double ELO_START = 1500;
+    static constexpr double ELO_PER_PRESTIGE = 50; // So the preseason order follows prestige
+    static constexpr double ELO_K = 32;
+    static constexpr int MARGIN_CAP = 28; // Same cap the poll uses, so nobody gains from running up the score
+    static constexpr double MASSEY_POINTS_PER_PRESTIGE = 3; // Each school's one "preseason game" is against an average team
+
+    struct Game {
+        int away;
+        int home;
+        int awayPoints;
+        int homePoints;
+    };
+
+    std::vector<School*> teams; // In a fixed order, which every rating vector follows
+    std::unordered_map<School*, int> teamIndex;
+    std::vector<Game> games; // Every game with a result before gamesWeek, in the order they were played
+    int gamesWeek = 0;
+    int eloGames = 0; // How many of the games are already in the Elo ratings
+    std::vector<double> elo, massey, colley;
+    int lastIterations = 0;
+
+    void catchUp(int week) {
+        for (; gamesWeek < week; gamesWeek++) {
+            for (School* team : teams) {
+                School::Matchup* m = team->getGameResults(gamesWeek);
+                if (m == nullptr || m->home != team || m->gameResult.homeStats == nullptr) continue;
+                games.push_back(Game{ teamIndex[m->away], teamIndex[m->home], m->gameResult.awayStats->points,
+                    m->gameResult.homeStats->points });
+            }
+        }
+    }
+
+    // The game graph's adjacency, negated, on top of the given diagonal
+    std::vector<std::vector<std::pair<int, double>>> gameGraphRows(double diagonal) {
+        std::vector<std::vector<std::pair<int, double>>> rows(teams.size());
+        for (int i = 0; i < (int)teams.size(); i++) rows[i].emplace_back(i, diagonal);
+        auto addEntry = [&](int row, int column, double value) {
+            for (auto& entry : rows[row]) {
+                if (entry.first == column) {
+                    entry.second += value;
+                    return;
+                }
+            }
+            rows[row].emplace_back(column, value);
+        };
+        for (const Game& g : games) {
+            addEntry(g.home, g.home, 1);
+            addEntry(g.away, g.away, 1);
+            addEntry(g.home, g.away, -1);
+            addEntry(g.away, g.home, -1);
+        }
+        return rows;
+    }
+
+    void updateElo() {
+        for (; eloGames < (int)games.size(); eloGames++) {
+            const Game& g = games[eloGames];
+            double expectedHome = 1.0 / (1.0 + std::pow(10.0, (elo[g.away] - elo[g.home]) / 400.0));
+            double actualHome = g.homePoints > g.awayPoints ? 1.0 : (g.homePoints < g.awayPoints ? 0.0 : 0.5);
+            int margin = std::min(std::abs(g.homePoints - g.awayPoints), MARGIN_CAP);
+            double change = ELO_K * std::log(margin + 1.0) * (actualHome - expectedHome);
+            elo[g.home] += change;
+            elo[g.away] -= change;
+        }
+    }
+
+    // Least squares over every point margin, plus one preseason game per school to pin down the ratings early on
+    void updateMassey() {
+        std::vector<double> b(teams.size());
+        for (int i = 0; i < (int)teams.size(); i++) b[i] = (teams[i]->getPrestige() - 5) * MASSEY_POINTS_PER_PRESTIGE;
+        for (const Game& g : games) {
+            int margin = std::max(-MARGIN_CAP, std::min(MARGIN_CAP, g.homePoints - g.awayPoints));
+            b[g.home] += margin;
+            b[g.away] -= margin;
+        }
+        lastIterations = SparseSystem(gameGraphRows(1)).solve(b, massey);
+    }
+
+    void updateColley() {
+        std::vector<double> b(teams.size(), 1);
+        for (const Game& g : games) {
+            if (g.homePoints == g.awayPoints) continue;
+            int winner = g.homePoints > g.awayPoints ? g.home : g.away;
+            int loser = winner == g.home ? g.away : g.home;
+            b[winner] += 0.5;
+            b[loser] -= 0.5;
+        }
+        lastIterations = SparseSystem(gameGraphRows(2)).solve(b, colley);
+    }
+
+    static std::vector<double> zScores(const std::vector<double>& ratings) {
+        double mean = 0, variance = 0;
+        for (double r : ratings) mean += r / ratings.size();
+        for (double r : ratings) variance += (r - mean) * (r - mean) / ratings.size();
+        double stdev = std::sqrt(variance);
+        std::vector<double> z;
+        for (double r : ratings) z.push_back(stdev > 0 ? (r - mean) / stdev : 0);
+        return z;
+    }
+
+public:
+    void reset(const std::vector<School*>& schools) {
+        teams = schools;
+        teamIndex.clear();
+        elo.clear();
+        for (int i = 0; i < (int)teams.size(); i++) {
+            teamIndex[teams[i]] = i;
+            elo.push_back(ELO_START + (teams[i]->getPrestige() - 5) * ELO_PER_PRESTIGE);
+        }
+        massey.assign(teams.size(), 0);
+        colley.assign(teams.size(), 0.5);
+        games.clear();
+        gamesWeek = 0;
+        eloGames = 0;
+        lastIterations = 0;
+    }
+
+    // Every school's rating after the games before the given week, higher is better. POLL reads each school's poll score.
+    std::vector<double> rate(RankingAlgorithm algorithm, int week) {
+        std::vector<double> poll;
+        for (School* team : teams) poll.push_back(team->getRankingScore());
+        catchUp(week);
+        switch (algorithm) {
+        case RankingAlgorithm::POLL: return poll;
+        case RankingAlgorithm::ELO: updateElo(); return elo;
+        case RankingAlgorithm::MASSEY: updateMassey(); return massey;
+        case RankingAlgorithm::COLLEY: updateColley(); return colley;
+        case RankingAlgorithm::BLENDED: {
+            updateElo();
+            updateMassey();
+            updateColley();
+            std::vector<double> blended(teams.size(), 0);
+            for (const std::vector<double>& ratings : { poll, elo, massey, colley }) {
+                std::vector<double> z = zScores(ratings);
+                for (int i = 0; i < (int)blended.size(); i++) blended[i] += z[i] / 4;
+            }
+            return blended;
+        }
+        }
+        return poll;
+    }
+
+    int getTeamIndex(School* school) { return teamIndex.at(school); }
+
+    // Conjugate gradient iterations in the latest Massey or Colley solve
+    int getLastIterations() { return lastIterations; }
+};
@@ -7,6 +7,45 @@ bool areSameConference(Conference div1, Conference div2) {
     return (getOppositeDivision(div1) == div2);
 }
 
+// The conferences that hold a championship game, between the winners of these two divisions
+const std::pair<Conference, Conference> CHAMPIONSHIP_GAME_DIVISIONS[] = { { BIGTENEAST, BIGTENWEST }, { SECEAST, SECWEST },
+                                                                          { ACCATLANTIC, ACCCOASTAL }, { PAC12NORTH, PAC12SOUTH } };
+
+/**
+ * Whoever is still level after a division's tiebreakers, in division order: most conference wins, then wins against each
+ * other when three or more are tied, then the head-to-head game when it's down to two. More than one left means a draw.
+ */
+template <typename Team, typename ConferenceWins, typename Beat>
+std::vector<Team> divisionTiebreak(const std::vector<Team>& division, ConferenceWins conferenceWins, Beat beat) {
+    int mostWins = 0;
+    for (const Team& team : division) mostWins = std::max(mostWins, (int)conferenceWins(team));
+    std::vector<Team> tied;
+    for (const Team& team : division) {
+        if (conferenceWins(team) == mostWins) tied.push_back(team);
+    }
+    if (tied.size() >= 3) {
+        std::vector<int> wins;
+        for (const Team& team : tied) {
+            int ourWins = 0;
+            for (const Team& opponent : tied) {
+                if (opponent != team && beat(team, opponent)) ourWins++;
+            }
+            wins.push_back(ourWins);
+        }
+        mostWins = 0;
+        for (int w : wins) mostWins = std::max(mostWins, w);
+        for (int i = (int)tied.size() - 1; i >= 0; i--) {
+            if (wins[i] < mostWins) tied.erase(tied.begin() + i);
+        }
+    }
+    if (tied.size() == 2) {
+        if (beat(tied[0], tied[1])) tied.erase(tied.begin() + 1);
+        else
+            tied.erase(tied.begin());
+    }
+    return tied;
+}
+
 class Scheduler {
     std::vector<std::vector<School>>* conferences;
     std::vector<School*> allSchools;
@@ -314,40 +353,13 @@ public:
     }
 
     void scheduleConferenceChampionshipGames() {
-        for (std::vector<Conference> set : { std::vector<Conference> { BIGTENEAST, BIGTENWEST }, std::vector<Conference> { SECEAST, SECWEST },
-                                             std::vector<Conference> { ACCATLANTIC, ACCCOASTAL }, std::vector<Conference> { PAC12NORTH, PAC12SOUTH } }) {
+        for (std::pair<Conference, Conference> divisions : CHAMPIONSHIP_GAME_DIVISIONS) {
             std::vector<School*> representatives;
-            for (Conference conf : set) {
-                int mostWins = 0;
-                for (auto& school : (*conferences)[conf]) {
-                    int schoolWins = school.getWinLossRecord(true).first;
-                    if (schoolWins > mostWins) mostWins = schoolWins;
-                }
-                std::vector<School*> tiedSchools;
-                for (auto& school : (*conferences)[conf]) {
-                    if (school.getWinLossRecord(true).first == mostWins) tiedSchools.push_back(&school);
-                }
-                if (tiedSchools.size() >= 3) {
-                    std::vector<int> wins;
-                    for (auto& school : tiedSchools) {
-                        int ourWins = 0;
-                        for (auto& opponent : tiedSchools) {
-                            if (opponent != school && school->didIWinAgainst(opponent)) ourWins++;
-                        }
-                        wins.push_back(ourWins);
-                    }
-                    mostWins = 0;
-                    for (auto& w : wins)
-                        if (w > mostWins) mostWins = w;
-                    for (int i = (int)tiedSchools.size() - 1; i >= 0; i--) {
-                        if (wins[i] < mostWins) tiedSchools.erase(tiedSchools.begin() + i);
-                    }
-                }
-                if (tiedSchools.size() == 2) {
-                    if (tiedSchools[0]->didIWinAgainst(tiedSchools[1])) tiedSchools.erase(tiedSchools.begin() + 1);
-                    else
-                        tiedSchools.erase(tiedSchools.begin());
-                }
+            for (Conference conf : { divisions.first, divisions.second }) {
+                std::vector<School*> division;
+                for (auto& school : (*conferences)[conf]) division.push_back(&school);
+                std::vector<School*> tiedSchools = divisionTiebreak(division, [](School* s) { return s->getWinLossRecord(true).first; },
+                                                                    [](School* a, School* b) { return a->didIWinAgainst(b); });
                 School* representative = tiedSchools[0];
                 if (tiedSchools.size() > 1) {
                     std::cout << "WARNING - tiebreakers failed for B1G CCG, using random draw\n";
@@ -359,19 +371,22 @@ public:
         }
     }
 
+    // Takes the top four in the latest rankings
     void schedulePlayoffs() {
+        std::vector<School*> byRanking = allSchools;
+        std::sort(byRanking.begin(), byRanking.end(), [](School* a, School* b) { return a->getRanking() < b->getRanking(); });
         std::vector<School*> fourTeams;
         int i = 0;
         while (fourTeams.size() < 4) {
             bool playedATeam = false;
             for (int j = 0; j < (int)fourTeams.size(); j++) {
-                if (allSchools[i]->getMatchupAgainst(fourTeams[j]) != nullptr) {
+                if (byRanking[i]->getMatchupAgainst(fourTeams[j]) != nullptr) {
                     playedATeam = true;
                     break;
                 }
             }
             // Temporarily killing this check - remove " || true " to prevent rematches
-            if (!playedATeam || true) fourTeams.push_back(allSchools[i]);
+            if (!playedATeam || true) fourTeams.push_back(byRanking[i]);
             i++;
         }
         assignMatchup(14, fourTeams[3], fourTeams[0]);
@@ -1,13 +1,31 @@
 #pragma once
 #include "../school.h"
+#include "rankingEngine.h"
+#include "seasonTable.h"
 
-struct SortByPublicRating {
-    bool operator()(School* a, School* b) { return (a->getRankingScore() > b->getRankingScore()); }
-};
+// One week's poll update for a school, from both rankings going into the game and its own point margin
+double updatedPollScore(double score, int ranking, int theirRanking, int pointMargin) {
+    if (pointMargin > 28) pointMargin = 28;
+    if (pointMargin < -28) pointMargin = -28;
+    if (pointMargin > 0) pointMargin += 14;
+    else pointMargin -= 14; // pointMargin is now between -42 and 42
+
+    double expectedPointMargin = (0.33 * theirRanking) - (0.33 * ranking) + 0.33;
+
+    // Constrain performance to roughly (-1, 1)
+    double performance = (pointMargin - expectedPointMargin) / 42.0;
+    // Adjust further to (0, 1)
+    performance = (performance + 1.0) * 0.5;
+
+    // Return a weighted average to prevent overreaction
+    return (score + (0.2 * performance)) / 1.2; // * ((week + 30) / 45.0);
+}
 
 class SchoolRanker {
 
-    std::vector<School*> allSchools;
+    std::vector<School*> allSchools; // Best ranked first
+    RankingAlgorithm algorithm = RankingAlgorithm::POLL;
+    RankingEngine engine;
 
     double decideNewRankingScore(School* school, int week) {
         week--;
@@ -15,42 +33,37 @@ class SchoolRanker {
         if (matchup != nullptr && matchup->gameResult.awayStats != nullptr) {
             std::pair<TeamStats*, TeamStats*> stats = school->getOrderedStats(matchup);
 
-            int pointMargin = stats.first->points - stats.second->points;
-            if (pointMargin > 28) pointMargin = 28;
-            if (pointMargin < -28) pointMargin = -28;
-            if (pointMargin > 0) pointMargin += 14;
-            else pointMargin -= 14; // pointMargin is now between -42 and 42
-
             bool away = matchup->away == school;
             int theirRanking = away ? matchup->home->getRanking() : matchup->away->getRanking();
-            double expectedPointMargin = (0.33 * theirRanking) - (0.33 * school->getRanking()) + 0.33;
-
-            // Constrain performance to roughly (-1, 1)
-            double performance = (pointMargin - expectedPointMargin) / 42.0;
-            // Adjust further to (0, 1)
-            performance = (performance + 1.0) * 0.5;
-
-            // Return a weighted average to prevent overreaction
-            return (school->getRankingScore() + (0.2 * performance)) / 1.2; // * ((week + 30) / 45.0);
+            return updatedPollScore(school->getRankingScore(), school->getRanking(), theirRanking, stats.first->points - stats.second->points);
         }
         return school->getRankingScore();
     }
 
 public:
+    void setAlgorithm(RankingAlgorithm a) { algorithm = a; }
+
     void resetPoll(std::vector<School*> schools) {
         allSchools = schools;
         for (auto& school : allSchools) {
             school->resetRankingScore(school->getPrestige() / 10.0);
         }
+        engine.reset(allSchools);
     }
 
+    // The poll always updates, since the blended ranking and conference tiebreakers use it. The selected algorithm decides
+    // the actual rankings.
     void rankTeams(int week) {
-        for (auto& school : allSchools) {
-            school->setRankingScore(decideNewRankingScore(school, week));
+        for (auto& school : allSchools) school->setRankingScore(decideNewRankingScore(school, week));
+        std::vector<double> ratings = engine.rate(algorithm, week);
+        std::vector<double> scores;
+        for (auto& school : allSchools) scores.push_back(ratings[engine.getTeamIndex(school)]);
+        std::vector<School*> lastWeek = allSchools;
+        std::vector<int> order = sortedOrder(scores, std::greater<double>());
+        for (int i = 0; i < (int)order.size(); i++) {
+            allSchools[i] = lastWeek[order[i]];
+            allSchools[i]->setRanking(i + 1);
         }
-        SortByPublicRating sbr;
-        std::sort(allSchools.begin(), allSchools.end(), sbr);
-        for (int i = 0; i < (int)allSchools.size(); i++) { allSchools[i]->setRanking(i + 1); }
     }
 
     void printAPTop25(int week) {
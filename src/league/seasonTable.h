@@ -0,0 +1,74 @@
+#pragma once
+#include "../school.h"
+
+#include <unordered_map>
+
+// Indices into keys, ordered so that a comes before b whenever better(keys[a], keys[b])
+template<typename Key, typename Better>
+std::vector<int> sortedOrder(const std::vector<Key>& keys, Better better) {
+    std::vector<int> order(keys.size());
+    for (int i = 0; i < (int)order.size(); i++) order[i] = i;
+    std::sort(order.begin(), order.end(), [&](int a, int b) { return better(keys[a], keys[b]); });
+    return order;
+}
+
+// One school's season so far, boiled down to what the rankings and standings sort on
+struct SeasonRow {
+    School* school;
+    std::pair<int, int> record;
+    std::pair<int, int> conferenceRecord;
+    double averageOffense; // Regular season yards per game
+    double averageDefense; // Regular season yards allowed per game
+};
+
+/**
+ * Every school's season aggregates, worked out once a week so that sorting never has to touch a schedule or merge box
+ * scores. Rows are in the order the schools were given. A rebuild only reads the games before the week it's given, so it
+ * can run while that week's games are still being played.
+ */
+class SeasonTable {
+    std::vector<SeasonRow> rows;
+    std::unordered_map<School*, int> rowIndex;
+
+public:
+    void rebuild(const std::vector<School*>& schools, int weeks = 16) {
+        rows.clear();
+        rowIndex.clear();
+        for (School* school : schools) {
+            std::pair<double, double> averages = school->getAverageOffenseDefense(weeks);
+            rowIndex[school] = rows.size();
+            rows.push_back(SeasonRow{ school, school->getWinLossRecord(false, weeks), school->getWinLossRecord(true, weeks),
+                averages.first, averages.second });
+        }
+    }
+
+    int size() const { return rows.size(); }
+    const SeasonRow& operator[](int i) const { return rows[i]; }
+    int getRowId(School* school) const { return rowIndex.at(school); }
+
+    // Row indices ordered by conference record, then overall record, then head to head and poll score
+    std::vector<int> standingsOrder(const std::vector<int>& rowIds) const {
+        std::vector<int> order = rowIds;
+        std::sort(order.begin(), order.end(), [this](int x, int y) {
+            const SeasonRow& a = rows[x];
+            const SeasonRow& b = rows[y];
+            for (bool v : { true, false }) {
+                std::pair<int, int> r1 = v ? a.conferenceRecord : a.record;
+                std::pair<int, int> r2 = v ? b.conferenceRecord : b.record;
+                if (r1.first > r2.first) return true;
+                if (r1.first < r2.first) return false;
+                if (r1.second < r2.second) return true;
+                if (r1.second > r2.second) return false;
+
+                if (v) {
+                    // Check the direct matchup between schools
+                    if (a.school->didIWinAgainst(b.school)) return true;
+                    if (b.school->didIWinAgainst(a.school)) return false;
+                }
+            }
+            // shrug
+            return (a.school->getRankingScore() > b.school->getRankingScore());
+        });
+        return order;
+    }
+};
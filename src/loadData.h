@@ -55,6 +55,7 @@ private:
 		NameData() {}
 		int totalFrequency = 0;
 		std::vector<std::pair<int, std::string>> names;
+		std::vector<int> cumulativeFrequency; // Running total of the frequencies, for binary searching
 		void readInData(std::string filename) {
 			std::fstream in(filename);
 			std::string line;
@@ -73,16 +74,13 @@ private:
 				iss >> freq;
 				names.push_back(std::make_pair(freq, name));
 				totalFrequency += freq;
+				cumulativeFrequency.push_back(totalFrequency);
 			}
 		}
+		// The first name whose running total reaches the roll
 		std::string getRandomName() {
-			int pointer = -1;
-			for (int index = std::rand() % totalFrequency; index > 0; index) {
-				pointer++;
-				index -= names[pointer].first;
-			}
-			if (pointer == -1) pointer = 0;
-			return names[pointer].second;
+			int roll = std::rand() % totalFrequency;
+			return names[std::lower_bound(cumulativeFrequency.begin(), cumulativeFrequency.end(), roll) - cumulativeFrequency.begin()].second;
 		}
 	};
 
@@ -167,7 +165,13 @@ private:
 	};
 
 	class CityData : public DataParser<City> {
-		std::unordered_map<std::string, int> totalStatePop;
+		// Indices into data of every city in a state, with a running total of their populations for binary searching
+		struct StateCities {
+			std::vector<int> cities;
+			std::vector<int> cumulativePop;
+		};
+		std::unordered_map<std::string, StateCities> citiesByState;
+
 		City parseLine(std::vector<std::string> row) {
 			City city;
 			city.name = row[0];
@@ -179,21 +183,23 @@ private:
 		}
 
 	public:
-		City* pickRandomCity(std::string state) {
-			if (totalStatePop.find(state) == totalStatePop.end()) {
-				totalStatePop[state] = 0;
-				for (City& city : data) {
-					if (city.state == state) totalStatePop[state] += city.population;
+		City* pickRandomCity(const std::string& state) {
+			auto it = citiesByState.find(state);
+			if (it == citiesByState.end()) {
+				StateCities sc;
+				int total = 0;
+				for (int i = 0; i < (int)data.size(); i++) {
+					if (data[i].state != state) continue;
+					total += data[i].population;
+					sc.cities.push_back(i);
+					sc.cumulativePop.push_back(total);
 				}
+				it = citiesByState.emplace(state, std::move(sc)).first;
 			}
-			int pointer = -1;
-			for (int index = std::rand() % totalStatePop[state]; index > 0; index) {
-				pointer++;
-				if (data[pointer].state != state) continue;
-				index -= data[pointer].population;
-			}
-			if (pointer == -1) pointer = 0;
-			return &(data[pointer]);
+			StateCities& sc = it->second;
+			int roll = std::rand() % sc.cumulativePop.back();
+			if (roll == 0) return &(data[0]); // The first city in the file, wherever it is. Seeded runs depend on this
+			return &(data[sc.cities[std::lower_bound(sc.cumulativePop.begin(), sc.cumulativePop.end(), roll) - sc.cumulativePop.begin()]]);
 		}
 
 		City* getCityByName(std::string stateCode, std::string name) {
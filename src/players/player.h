@@ -1,13 +1,17 @@
 #pragma once
 
 #include "../loadData.h"
+#include "../slotPool.h"
 #include "../util.h"
 
+#include <algorithm>
+#include <array>
 #include <cassert>
 #include <cmath>
 #include <iostream>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 enum Position { QB, HB, WR, TE, OL, DL, LB, CB, S, K, P };
 
@@ -140,89 +144,85 @@ const double INJURY_RISK_LOW = 0.001; // 0.1%
 const double INJURY_RISK_MEDIUM = 0.0025; // 0.25%
 const double INJURY_RISK_HIGH = 0.003; // 0.3%
 
-std::pair<std::vector<std::pair<Rating, int>>, std::vector<std::pair<Rating, int>>> getRatingFactors(Position p) {
-	using f = std::pair<Rating, int>;
-	using n = std::pair<std::vector<f>, std::vector<f>>;
-	switch (p) {
-	case QB:
-		return n(
-			{ f(SPEED, 70), f(PASSVISION, 99), f(PASSPOWER, 99), f(PASSACCURACY, 99), f(BREAKTACKLE, 75), f(BALLSECURITY, 70),
-			  f(KICKPOWER, 40), f(KICKACCURACY, 50), f(PUNTPOWER, 40), f(PUNTACCURACY, 50) },
-
-			{ f(SPEED, 95), f(PASSVISION, 99), f(PASSPOWER, 90), f(PASSACCURACY, 90), f(BREAKTACKLE, 95), f(BALLSECURITY, 85),
-			  f(KICKPOWER, 60), f(KICKACCURACY, 40), f(PUNTPOWER, 60), f(PUNTACCURACY, 40) });
-	case HB:
-		return n({ f(SPEED, 85), f(STRENGTH, 90), f(BREAKTACKLE, 99), f(BALLSECURITY, 99), f(RUNBLOCK, 90), f(PASSBLOCK, 70), f(CATCH, 80),
-				   f(GETTINGOPEN, 70), f(PASSVISION, 40), f(PASSPOWER, 60), f(PASSACCURACY, 40), f(TACKLE, 60) },
-
-			{ f(SPEED, 99), f(STRENGTH, 70), f(BREAKTACKLE, 90), f(BALLSECURITY, 95), f(RUNBLOCK, 60), f(PASSBLOCK, 85), f(CATCH, 85),
-			f(GETTINGOPEN, 85), f(PASSVISION, 40), f(PASSPOWER, 40), f(PASSACCURACY, 60), f(TACKLE, 60) });
-	case WR:
-		return n(
-			{ f(SPEED, 90), f(STRENGTH, 85), f(BREAKTACKLE, 70), f(RUNBLOCK, 70), f(CATCH, 99), f(BALLSECURITY, 99),
-			  f(GETTINGOPEN, 99), f(PASSVISION, 40), f(PASSPOWER, 60), f(PASSACCURACY, 40), f(PASSCOVER, 50), f(TACKLE, 70) },
-
-			{ f(SPEED, 99), f(STRENGTH, 70), f(BREAKTACKLE, 85), f(RUNBLOCK, 60), f(CATCH, 95), f(BALLSECURITY, 90),
-			  f(GETTINGOPEN, 95), f(PASSVISION, 40), f(PASSPOWER, 40), f(PASSACCURACY, 60), f(PASSCOVER, 70), f(TACKLE, 50) });
-	case TE:
-		return n({ f(SPEED, 75), f(STRENGTH, 95), f(BREAKTACKLE, 70), f(BALLSECURITY, 85), f(CATCH, 85), f(RUNBLOCK, 90),
-				   f(PASSBLOCK, 90), f(GETTINGOPEN, 80) },
-
-			{ f(SPEED, 90), f(STRENGTH, 85), f(BREAKTACKLE, 80), f(BALLSECURITY, 90), f(CATCH, 95), f(RUNBLOCK, 65),
-			  f(PASSBLOCK, 70), f(GETTINGOPEN, 90) });
-
-	case OL:
-		return n({ f(STRENGTH, 99), f(RUNBLOCK, 99), f(PASSBLOCK, 90), f(TACKLE, 60) },
-
-			{ f(STRENGTH, 99), f(RUNBLOCK, 90), f(PASSBLOCK, 99), f(TACKLE, 60) });
-
-	case DL:
-		return n({ f(STRENGTH, 99), f(SPEED, 70), f(RUNSTOP, 99), f(PASSRUSH, 90), f(TACKLE, 99), f(STRIPBALL, 75), f(PASSCOVER, 60) },
-
-			{ f(STRENGTH, 90), f(SPEED, 85), f(RUNSTOP, 90), f(PASSRUSH, 99), f(TACKLE, 95), f(STRIPBALL, 80), f(PASSCOVER, 70) });
-	case LB:
-		return n({ f(STRENGTH, 95), f(SPEED, 80), f(RUNSTOP, 95), f(PASSRUSH, 80), f(PASSCOVER, 80), f(TACKLE, 95), f(STRIPBALL, 90), f(CATCH, 65) },
-
-			{ f(STRENGTH, 85), f(SPEED, 90), f(RUNSTOP, 80), f(PASSRUSH, 85), f(PASSCOVER, 95), f(TACKLE, 90), f(STRIPBALL, 80), f(CATCH, 75) });
-	case CB:
-		return n(
-			{ f(STRENGTH, 85), f(SPEED, 95), f(PASSCOVER, 95), f(TACKLE, 95), f(STRIPBALL, 90), f(PASSRUSH, 80), f(RUNSTOP, 85),
-			  f(CATCH, 80), f(BREAKTACKLE, 60), f(GETTINGOPEN, 60), f(BALLSECURITY, 60) },
-
-			{ f(STRENGTH, 80), f(SPEED, 99), f(PASSCOVER, 99), f(TACKLE, 85), f(STRIPBALL, 80), f(PASSRUSH, 70), f(RUNSTOP, 65),
-			  f(CATCH, 95), f(BREAKTACKLE, 50), f(GETTINGOPEN, 65), f(BALLSECURITY, 60) });
-	case S:
-		return n({ f(STRENGTH, 90), f(SPEED, 90), f(PASSCOVER, 90), f(TACKLE, 99), f(STRIPBALL, 95), f(PASSRUSH, 80), f(RUNSTOP, 85), f(CATCH, 80) },
-
-			{ f(STRENGTH, 85), f(SPEED, 95), f(PASSCOVER, 99), f(TACKLE, 90), f(STRIPBALL, 80), f(PASSRUSH, 70), f(RUNSTOP, 65), f(CATCH, 90) });
-	case K:
-		return n({ f(KICKPOWER, 99), f(KICKACCURACY, 90), f(PUNTPOWER, 80), f(PUNTACCURACY, 70) },
-
-			{ f(KICKPOWER, 90), f(KICKACCURACY, 99), f(PUNTPOWER, 70), f(PUNTACCURACY, 80) });
-	case P:
-		return n({ f(KICKPOWER, 80), f(KICKACCURACY, 70), f(PUNTPOWER, 99), f(PUNTACCURACY, 90) },
-
-			{ f(KICKPOWER, 70), f(KICKACCURACY, 80), f(PUNTPOWER, 90), f(PUNTACCURACY, 99) });
-	default: return n({}, {});
-	};
-}
+struct RatingFactor {
+	Rating rating;
+	int first; // Value at archetype pointer 0
+	int second; // Value at archetype pointer 1
+};
+
+struct RatingFactors {
+	int size;
+	std::array<RatingFactor, 12> factors;
+
+	constexpr const RatingFactor* begin() const { return factors.data(); }
+	constexpr const RatingFactor* end() const { return factors.data() + size; }
+};
+
+// This MUST MATCH UP with the order of the Position enum!
+constexpr std::array<RatingFactors, 11> RATING_FACTORS = { {
+	RatingFactors{ 10, { { // QB
+		  { SPEED, 70, 95 }, { PASSVISION, 99, 99 }, { PASSPOWER, 99, 90 }, { PASSACCURACY, 99, 90 }, { BREAKTACKLE, 75, 95 }, { BALLSECURITY, 70, 85 },
+		  { KICKPOWER, 40, 60 }, { KICKACCURACY, 50, 40 }, { PUNTPOWER, 40, 60 }, { PUNTACCURACY, 50, 40 } } } },
+	RatingFactors{ 12, { { // HB
+		  { SPEED, 85, 99 }, { STRENGTH, 90, 70 }, { BREAKTACKLE, 99, 90 }, { BALLSECURITY, 99, 95 }, { RUNBLOCK, 90, 60 }, { PASSBLOCK, 70, 85 },
+		  { CATCH, 80, 85 }, { GETTINGOPEN, 70, 85 }, { PASSVISION, 40, 40 }, { PASSPOWER, 60, 40 }, { PASSACCURACY, 40, 60 }, { TACKLE, 60, 60 } } } },
+	RatingFactors{ 12, { { // WR
+		  { SPEED, 90, 99 }, { STRENGTH, 85, 70 }, { BREAKTACKLE, 70, 85 }, { RUNBLOCK, 70, 60 }, { CATCH, 99, 95 }, { BALLSECURITY, 99, 90 },
+		  { GETTINGOPEN, 99, 95 }, { PASSVISION, 40, 40 }, { PASSPOWER, 60, 40 }, { PASSACCURACY, 40, 60 }, { PASSCOVER, 50, 70 }, { TACKLE, 70, 50 } } } },
+	RatingFactors{ 8, { { // TE
+		  { SPEED, 75, 90 }, { STRENGTH, 95, 85 }, { BREAKTACKLE, 70, 80 }, { BALLSECURITY, 85, 90 }, { CATCH, 85, 95 }, { RUNBLOCK, 90, 65 },
+		  { PASSBLOCK, 90, 70 }, { GETTINGOPEN, 80, 90 } } } },
+	RatingFactors{ 4, { { // OL
+		  { STRENGTH, 99, 99 }, { RUNBLOCK, 99, 90 }, { PASSBLOCK, 90, 99 }, { TACKLE, 60, 60 } } } },
+	RatingFactors{ 7, { { // DL
+		  { STRENGTH, 99, 90 }, { SPEED, 70, 85 }, { RUNSTOP, 99, 90 }, { PASSRUSH, 90, 99 }, { TACKLE, 99, 95 }, { STRIPBALL, 75, 80 },
+		  { PASSCOVER, 60, 70 } } } },
+	RatingFactors{ 8, { { // LB
+		  { STRENGTH, 95, 85 }, { SPEED, 80, 90 }, { RUNSTOP, 95, 80 }, { PASSRUSH, 80, 85 }, { PASSCOVER, 80, 95 }, { TACKLE, 95, 90 },
+		  { STRIPBALL, 90, 80 }, { CATCH, 65, 75 } } } },
+	RatingFactors{ 11, { { // CB
+		  { STRENGTH, 85, 80 }, { SPEED, 95, 99 }, { PASSCOVER, 95, 99 }, { TACKLE, 95, 85 }, { STRIPBALL, 90, 80 }, { PASSRUSH, 80, 70 },
+		  { RUNSTOP, 85, 65 }, { CATCH, 80, 95 }, { BREAKTACKLE, 60, 50 }, { GETTINGOPEN, 60, 65 }, { BALLSECURITY, 60, 60 } } } },
+	RatingFactors{ 8, { { // S
+		  { STRENGTH, 90, 85 }, { SPEED, 90, 95 }, { PASSCOVER, 90, 99 }, { TACKLE, 99, 90 }, { STRIPBALL, 95, 80 }, { PASSRUSH, 80, 70 },
+		  { RUNSTOP, 85, 65 }, { CATCH, 80, 90 } } } },
+	RatingFactors{ 4, { { // K
+		  { KICKPOWER, 99, 90 }, { KICKACCURACY, 90, 99 }, { PUNTPOWER, 80, 70 }, { PUNTACCURACY, 70, 80 } } } },
+	RatingFactors{ 4, { { // P
+		  { KICKPOWER, 80, 70 }, { KICKACCURACY, 70, 80 }, { PUNTPOWER, 99, 90 }, { PUNTACCURACY, 90, 99 } } } }
+} };
+
+constexpr const RatingFactors& getRatingFactors(Position p) { return RATING_FACTORS[p]; }
+
+constexpr int RATINGS_VECTOR_SIZE = 21;
 
 std::vector<int> createRatingsVector(Position p, int ovr, double archetypePointer) {
-	using Archetype = std::vector<std::pair<Rating, int>>;
-	std::vector<int> rats(21, 1); // Every rating defaults to a 1
-	std::pair<Archetype, Archetype> archetypes = getRatingFactors(p);
-	Archetype a = archetypes.first;
-	for (int i = 0; i < (int)a.size(); i++) {
-		int diff = archetypes.second[i].second - a[i].second;
-		a[i].second += std::round(diff * archetypePointer);
-		rats[(int)a[i].first] = std::round(a[i].second * (ovr / 99.0));
+	std::vector<int> rats(RATINGS_VECTOR_SIZE, 1); // Every rating defaults to a 1
+	for (const RatingFactor& f : getRatingFactors(p)) {
+		int rating = f.first + std::round((f.second - f.first) * archetypePointer);
+		rats[f.rating] = std::round(rating * (ovr / 99.0));
 	}
 	return rats;
 }
 
-int estimateOutOfPositionOvr(std::vector<int> ratings, Position p) {
-	// Use center archetype pointer to get "average" player ratings
-	std::vector<int> idealRatings = createRatingsVector(p, 99, 0.5);
+// std::round isn't constexpr until C++23
+constexpr int roundHalfAwayFromZero(double x) { return x < 0 ? -(int)(-x + 0.5) : (int)(x + 0.5); }
+
+// The "ideal" ratings at each position, i.e. createRatingsVector(p, 99, 0.5), using the center archetype pointer to get
+// an "average" player
+constexpr std::array<std::array<int, RATINGS_VECTOR_SIZE>, 11> IDEAL_RATINGS = [] {
+	std::array<std::array<int, RATINGS_VECTOR_SIZE>, 11> ideals{};
+	for (int p = 0; p < 11; p++) {
+		for (int& rating : ideals[p]) rating = 1;
+		for (const RatingFactor& f : RATING_FACTORS[p]) ideals[p][f.rating] = f.first + roundHalfAwayFromZero((f.second - f.first) * 0.5);
+	}
+	return ideals;
+}();
+
+constexpr const std::array<int, RATINGS_VECTOR_SIZE>& getIdealRatings(Position p) { return IDEAL_RATINGS[p]; }
+
+int estimateOutOfPositionOvr(const std::vector<int>& ratings, Position p) {
+	const std::array<int, RATINGS_VECTOR_SIZE>& idealRatings = getIdealRatings(p);
 	double ratingDiffTotal = 0;
 	int totalValidRatings = 0;
 	for (int i = 0; i < (int)idealRatings.size(); i++) {
@@ -233,8 +233,13 @@ int estimateOutOfPositionOvr(std::vector<int> ratings, Position p) {
 	return std::floor(ratingDiffTotal / totalValidRatings);
 }
 
+class Player;
+class Roster;
+using PlayerHandle = Handle<Player>;
+
 class Player {
 private:
+	PlayerHandle handle; // Only set once the player is on a roster
 	std::string name;
 	Position position;
 	int year;
@@ -258,6 +263,8 @@ public:
 	Player(std::string n, Position p, int y, int OVR, int pot, const std::vector<int>& rats, double arch) :
 		name{ n }, position{ p }, year{ y }, ovr{ OVR }, potentialOvr{ pot }, ratings{ rats }, archetypePointer{ arch } {};
 
+	PlayerHandle getHandle() const { return handle; }
+	void setHandle(PlayerHandle h) { handle = h; }
 	std::string getName() const { return name; }
 	Position getPosition() const { return position; }
 	std::string getPositionedName() const {
@@ -278,9 +285,10 @@ public:
 	int getOVR() const { return ovr; }
 	int getLastTrainingResult() const { return lastTrainingResult; }
 	int getWeeksInjured() const { return injuredWeeks; }
+	void setWeeksInjured(int weeks) { injuredWeeks = weeks; }
 	bool isInjured() const { return injuredWeeks != 0; }
 	City* getHometown() const { return hometown; }
-	std::vector<int> getRatingsVector() const { return ratings; }
+	const std::vector<int>& getRatingsVector() const { return ratings; }
 	int getRating(Rating r, bool stripBonus = false) const {
 		// Gametime "bonus" is a bit of a misnomer. Lack of a bonus is penalizing and a full bonus simply does nothing.
 		int penalty = 15;
@@ -294,15 +302,51 @@ public:
 		return (year > 4);
 	}
 	void train(double trainingMultiplier) {
-		double penalty = 3.0 - (trainingMultiplier * 4.0);
-		double amount = (potentialOvr - ovr) / (5 - year);
-		amount = std::round(amount - penalty);
-		if (ovr + amount > 99) amount = 99 - ovr;
+		Player* self = this;
+		trainBatch(&self, 1, trainingMultiplier);
+	}
+	/**
+	 * Trains a batch of players who all play the same position. Gives the same results as calling train() on each of
+	 * them, but the math runs down flat columns (one per stat, one per rating) and ratings get rewritten in place
+	 * instead of reallocated. Touches nothing but the given players, so separate batches can train concurrently.
+	 */
+	static void trainBatch(Player* const* players, int n, double trainingMultiplier) {
+		if (n == 0) return;
+		const Position pos = players[0]->position;
+		const double penalty = 3.0 - (trainingMultiplier * 4.0);
+
+		std::vector<int> ovrs(n), amounts(n);
+		std::vector<double> archetypes(n);
+		for (int j = 0; j < n; j++) {
+			const Player* p = players[j];
+			assert(p->position == pos);
+			double amount = (p->potentialOvr - p->ovr) / (5 - p->year);
+			amounts[j] = std::round(amount - penalty);
+			ovrs[j] = p->ovr;
+			archetypes[j] = p->archetypePointer;
+		}
+		for (int j = 0; j < n; j++) {
+			if (ovrs[j] + amounts[j] > 99) amounts[j] = 99 - ovrs[j];
+			ovrs[j] += amounts[j];
+		}
 
-		lastTrainingResult = amount;
-		ovr += amount;
+		for (int j = 0; j < n; j++) {
+			Player* p = players[j];
+			p->lastTrainingResult = amounts[j];
+			p->ovr = ovrs[j];
+			if ((int)p->ratings.size() != RATINGS_VECTOR_SIZE) p->ratings.assign(RATINGS_VECTOR_SIZE, 1);
+		}
 
-		ratings = createRatingsVector(position, ovr, archetypePointer);
+		// Same as createRatingsVector, one rating at a time across the whole batch
+		std::vector<int> column(n);
+		for (const RatingFactor& f : getRatingFactors(pos)) {
+			const int diff = f.second - f.first;
+			for (int j = 0; j < n; j++) {
+				int rating = f.first + std::round(diff * archetypes[j]);
+				column[j] = std::round(rating * (ovrs[j] / 99.0));
+			}
+			for (int j = 0; j < n; j++) players[j]->ratings[f.rating] = column[j];
+		}
 	}
 	// This is mostly for testing/debugging. Shouldn't be any use case in real settings
 	void setOvr(int o) {
@@ -311,6 +355,7 @@ public:
 	}
 
 	void setGametimeBonus(double b) { gametimeBonus = b; }
+	double getGametimeBonus() const { return gametimeBonus; }
 	bool runInjuryRisk(double injuryRisk) {
 		const double x = RNG::randomNumberUniformDist();
 		if (x < injuryRisk) {
@@ -350,6 +395,40 @@ Player playerFactory(Position p, int y, int prestige, int o = -1, int pot = 99)
 	return Player(name, p, y, ovr, pot, rats, archetypePointer);
 }
 
+/**
+ * Estimates every given player's OVR at every position, returned as [position][player]. This is the same math as
+ * estimateOutOfPositionOvr, but the ratings get transposed into one column per rating first so the inner loop runs across
+ * all players at once and vectorizes.
+ */
+std::vector<std::vector<int>> estimateOutOfPositionOvrs(const std::vector<Player*>& players) {
+	const int n = players.size();
+	const int numRatings = RATINGS_VECTOR_SIZE;
+	std::vector<std::vector<double>> columns(numRatings, std::vector<double>(n));
+	for (int j = 0; j < n; j++) {
+		const std::vector<int>& ratings = players[j]->getRatingsVector();
+		assert((int)ratings.size() >= numRatings);
+		for (int r = 0; r < numRatings; r++) columns[r][j] = ratings[r];
+	}
+
+	std::vector<std::vector<int>> ovrs(11, std::vector<int>(n));
+	std::vector<double> totals(n);
+	for (Position p : { QB, HB, WR, TE, OL, DL, LB, CB, S, K, P }) {
+		const std::array<int, RATINGS_VECTOR_SIZE>& idealRatings = getIdealRatings(p);
+		std::fill(totals.begin(), totals.end(), 0.0);
+		int totalValidRatings = 0;
+		for (int r = 0; r < numRatings; r++) {
+			if (idealRatings[r] < 70) continue;
+			const double ideal = idealRatings[r];
+			const double* column = columns[r].data();
+			double* total = totals.data();
+			for (int j = 0; j < n; j++) total[j] += std::min(99.0, (column[j] / ideal) * 100.0);
+			totalValidRatings += 1;
+		}
+		for (int j = 0; j < n; j++) ovrs[p][j] = std::floor(totals[j] / totalValidRatings);
+	}
+	return ovrs;
+}
+
 struct PlayerStats {
 	int rushes;
 	int rushingYards;
@@ -417,50 +496,59 @@ struct TeamStats {
 
 	int yardsAllowed = 0;
 
-	std::unordered_map<Player*, PlayerStats> players;
+	std::unordered_map<PlayerHandle, PlayerStats, HandleHash<Player>> players;
+	Roster* roster = nullptr; // The roster these players' handles belong to
+
+	// Plays without a real participant (e.g. nobody to throw to) get filed under the null handle
+	PlayerStats& statsFor(Player* p) { return players[p == nullptr ? PlayerHandle() : p->getHandle()]; }
 
 	void recordRush(Player* runner, int yards) {
-		players[runner].rushes++;
-		players[runner].rushingYards += yards;
+		PlayerStats& stats = statsFor(runner);
+		stats.rushes++;
+		stats.rushingYards += yards;
 		timeOfPossession += 30;
 	}
 	void recordPass(Player* qb, Player* receiver, int yards, bool complete) {
+		PlayerStats& qbStats = statsFor(qb);
 		if (complete) {
-			players[qb].passingYards += yards;
-			players[receiver].receivingYards += yards;
-			players[qb].completions++;
-			players[receiver].catches++;
+			PlayerStats& receiverStats = statsFor(receiver);
+			qbStats.passingYards += yards;
+			receiverStats.receivingYards += yards;
+			qbStats.completions++;
+			receiverStats.catches++;
 		} else
-			players[qb].incompletions++;
+			qbStats.incompletions++;
 		timeOfPossession += 30;
 	}
-	void recordDrop(Player* dropper) { players[dropper].drops++; }
-	void recordRushingTD(Player* scorer) { players[scorer].rushingTDs++; }
+	void recordDrop(Player* dropper) { statsFor(dropper).drops++; }
+	void recordRushingTD(Player* scorer) { statsFor(scorer).rushingTDs++; }
 	void recordPassingTD(Player* qb, Player* receiver) {
-		players[qb].passingTDs++;
-		players[receiver].receivingTDs++;
+		statsFor(qb).passingTDs++;
+		statsFor(receiver).receivingTDs++;
 	}
 
 	void recordYardsAllowed(int yds) { yardsAllowed += yds; }
-	void recordTackle(Player* p) { players[p].tackles++; }
-	void recordSack(Player* p) { players[p].sacks++; }
-	void recordTFL(Player* p) { players[p].TFLs++; }
-	void recordPassDefense(Player* p) { players[p].passDefenses++; }
+	void recordTackle(Player* p) { statsFor(p).tackles++; }
+	void recordSack(Player* p) { statsFor(p).sacks++; }
+	void recordTFL(Player* p) { statsFor(p).TFLs++; }
+	void recordPassDefense(Player* p) { statsFor(p).passDefenses++; }
 	void recordSackAllowed() { sacksAllowed++; }
-	void recordINTThrown(Player* p) { players[p].INTsThrown++; }
-	void recordINTCaught(Player* p) { players[p].INTsCaught++; }
-	void recordFumble(Player* p) { players[p].fumblesLost++; }
+	void recordINTThrown(Player* p) { statsFor(p).INTsThrown++; }
+	void recordINTCaught(Player* p) { statsFor(p).INTsCaught++; }
+	void recordFumble(Player* p) { statsFor(p).fumblesLost++; }
 	void recordFGAttempt(Player* p, bool made, int distance) {
+		PlayerStats& stats = statsFor(p);
 		if (made) {
-			players[p].FGsMade++;
-			if (players[p].longestFG < distance) players[p].longestFG = distance;
+			stats.FGsMade++;
+			if (stats.longestFG < distance) stats.longestFG = distance;
 		} else
-			players[p].FGsMissed++;
+			stats.FGsMissed++;
 	}
 	void recordPunt(Player* p, int distance) {
-		players[p].punts++;
-		players[p].puntYards += distance;
-		if (players[p].longestPunt < distance) players[p].longestPunt = distance;
+		PlayerStats& stats = statsFor(p);
+		stats.punts++;
+		stats.puntYards += distance;
+		if (stats.longestPunt < distance) stats.longestPunt = distance;
 	}
 
 	int rushes() {
@@ -628,7 +716,7 @@ struct TeamStats {
 	}
 
 	void printPlayerStats(Player* p) {
-		const PlayerStats& s = players[p];
+		const PlayerStats& s = statsFor(p);
 		bool agg = (games > 1);
 		double dGames = (double)games;
 		std::cout << positionToStr(p->getPosition()) << " " << p->getName() << " (" << p->getOVR() << " OVR)\n";
@@ -690,14 +778,27 @@ struct TeamStats {
 		}
 	}
 
-	std::vector<Player*> getPlayersRecorded() const {
-		std::vector<Player*> recorded;
-		for (auto p : players) recorded.push_back(p.first);
+	// Back to a fresh game's numbers, keeping every player's entry so the next game doesn't have to allocate them again
+	void clearForReuse() {
+		points = 0;
+		numPossessions = 0;
+		timeOfPossession = 0;
+		sacksAllowed = 0;
+		yardsAllowed = 0;
+		for (auto& player : players) player.second = PlayerStats();
+	}
+
+	std::vector<PlayerHandle> getPlayersRecorded() const {
+		std::vector<PlayerHandle> recorded;
+		for (auto p : players) {
+			if (!p.first.isNull()) recorded.push_back(p.first);
+		}
 		return recorded;
 	}
 
 	TeamStats& operator+=(TeamStats& rhs) {
-		for (Player* player : rhs.getPlayersRecorded()) { this->players[player] += rhs.players[player]; }
+		if (this->roster == nullptr) this->roster = rhs.roster;
+		for (auto& player : rhs.players) { this->players[player.first] += player.second; }
 		this->sacksAllowed += rhs.sacksAllowed;
 		this->numPossessions += rhs.numPossessions;
 		this->yardsAllowed += rhs.yardsAllowed;
@@ -708,11 +809,19 @@ struct TeamStats {
 	}
 };
 
+// An injury picked up in a game, put on the real player only once the game's result is committed
+struct InjuryDelta {
+	PlayerHandle player;
+	int weeks;
+};
+
 struct GameResult {
 	TeamStats* awayStats = nullptr;
 	TeamStats* homeStats = nullptr;
 	bool awayWon;
 	bool homeWon;
+	std::vector<InjuryDelta> awayInjuries;
+	std::vector<InjuryDelta> homeInjuries;
 
 	GameResult& operator+=(GameResult& rhs) {
 		*(this->awayStats) += *(rhs.awayStats);
@@ -1,8 +1,10 @@
 #pragma once
 
 #include "player.h"
+#include "../slotPool.h"
 
 #include <algorithm>
+#include <array>
 #include <cassert>
 #include <iostream>
 #include <string>
@@ -23,31 +25,110 @@ struct SortByRating {
 	}
 };
 
-struct SortByOutOfPositionOvr {
-	Position position;
-
-	SortByOutOfPositionOvr(Position p) : position(p) {}
-
-	bool operator()(const Player* p1, const Player* p2) {
-		int ovr1 = estimateOutOfPositionOvr(p1->getRatingsVector(), position);
-		int ovr2 = estimateOutOfPositionOvr(p2->getRatingsVector(), position);
-		return (ovr1 > ovr2);
-	}
-};
-
 struct Needs {
 	Position pos;
 	int num;
 };
 
+// The players needed on the field for one formation, in the order they're picked
+struct Personnel {
+	int size;
+	std::array<Needs, 5> needs;
+
+	constexpr const Needs* begin() const { return needs.data(); }
+	constexpr const Needs* end() const { return needs.data() + size; }
+};
+
 // 					  { QB,HB,WR,TE,OL,DL,LB,CB,S,K,P }
 int startingCount[] = { 1, 1, 3, 1, 5, 4, 3, 2, 2,1,1 };
 
+// Everything on a roster that changes from one game to the next: who's hurt, and each player's gametime bonus
+struct RosterState {
+	std::vector<int> weeksInjured;
+	std::vector<double> gametimeBonuses;
+};
+
+// Non-owning, read-only view over one position's players, best OVR first. Only valid until the roster is next modified.
+class PositionView {
+	const std::vector<Player*>* bucket;
+
+public:
+	using iterator = std::vector<Player*>::const_iterator;
+
+	PositionView(const std::vector<Player*>* b) : bucket(b) {}
+
+	int size() const { return bucket->size(); }
+	bool empty() const { return bucket->empty(); }
+	Player* operator[](int i) const { return (*bucket)[i]; }
+	iterator begin() const { return bucket->begin(); }
+	iterator end() const { return bucket->end(); }
+};
+
 class Roster {
 private:
-	std::vector<Player> roster; // This is where all players actually live!
+	SlotPool<Player> players; // This is where all players actually live!
+	std::vector<Player*> positionBuckets[11]; // Each position's players, sorted by OVR (best first)
 	std::vector<std::vector<Player*>> depthChart;
-	int startingPrestige;
+	int startingPrestige = 0;
+
+	void insertIntoBucket(Player* player) {
+		std::vector<Player*>& bucket = positionBuckets[player->getPosition()];
+		auto it = std::upper_bound(bucket.begin(), bucket.end(), player, SortByOVR());
+		bucket.insert(it, player);
+	}
+
+	void sortBucket(Position p) {
+		std::vector<Player*>& bucket = positionBuckets[p];
+		// Buckets are already nearly sorted after training, so a stable insertion pass is all that's needed
+		for (int i = 1; i < (int)bucket.size(); i++) {
+			Player* player = bucket[i];
+			int j = i - 1;
+			for (; j >= 0 && bucket[j]->getOVR() < player->getOVR(); j--) bucket[j + 1] = bucket[j];
+			bucket[j + 1] = player;
+		}
+	}
+
+	void removeFromBucket(Player* player) {
+		std::vector<Player*>& bucket = positionBuckets[player->getPosition()];
+		bucket.erase(std::find(bucket.begin(), bucket.end(), player));
+	}
+
+	void addToDepthChart(Player* player) {
+		if (depthChart.empty()) return;
+		Position pos = player->getPosition();
+		for (int p = 0; p < (int)depthChart.size(); p++) {
+			std::vector<Player*>& chart = depthChart[p];
+			if (p != pos) {
+				// Out-of-position spots get properly ranked at the next organizeDepthChart()
+				chart.push_back(player);
+				continue;
+			}
+			auto it = std::find_if(chart.begin(), chart.end(),
+				[&](Player* other) { return other->getPosition() != pos || other->getOVR() < player->getOVR(); });
+			chart.insert(it, player);
+		}
+	}
+
+	void relinkFrom(const Roster& other) {
+		// Slots and generations are copied along with the pool, so a handle finds the same player in the copy
+		auto relink = [this](const std::vector<Player*>& from) {
+			std::vector<Player*> to;
+			to.reserve(from.size());
+			for (Player* player : from) to.push_back(players.get(player->getHandle()));
+			return to;
+		};
+		for (int p = 0; p < 11; p++) positionBuckets[p] = relink(other.positionBuckets[p]);
+		depthChart.clear();
+		for (auto& chart : other.depthChart) depthChart.push_back(relink(chart));
+	}
+
+	void addGeneratedPlayers(const std::vector<std::pair<Position, int>>& orders) {
+		for (auto order : orders) {
+			for (int i = 0; i < order.second; ++i) {
+				addPlayer(playerFactory(order.first, (std::rand() % 4) + 1, startingPrestige));
+			}
+		}
+	}
 
 	void generateOffRoster() {
 		/*
@@ -58,12 +139,7 @@ private:
 		9 WR
 		33 TOTAL
 		*/
-		std::vector<std::pair<Position, int>> orders{ std::make_pair(QB, 4), std::make_pair(HB, 5), std::make_pair(OL, 11), std::make_pair(TE, 4),
-													   std::make_pair(WR, 9) };
-
-		for (auto order : orders) {
-			for (int i = 0; i < order.second; ++i) roster.push_back(playerFactory(order.first, (std::rand() % 4) + 1, startingPrestige));
-		}
+		addGeneratedPlayers({ std::make_pair(QB, 4), std::make_pair(HB, 5), std::make_pair(OL, 11), std::make_pair(TE, 4), std::make_pair(WR, 9) });
 	}
 
 	void generateDefRoster() {
@@ -74,47 +150,66 @@ private:
 		6 S
 		33 TOTAL
 		*/
-		std::vector<std::pair<Position, int>> orders{ std::make_pair(DL, 10), std::make_pair(LB, 9), std::make_pair(CB, 8), std::make_pair(S, 6) };
-
-		for (auto order : orders) {
-			for (int i = 0; i < order.second; ++i) roster.push_back(playerFactory(order.first, (std::rand() % 4) + 1, startingPrestige));
-		}
+		addGeneratedPlayers({ std::make_pair(DL, 10), std::make_pair(LB, 9), std::make_pair(CB, 8), std::make_pair(S, 6) });
 	}
 
-	void generateSpecialTeams() {
-		std::vector<std::pair<Position, int>> orders{ std::make_pair(P, 2), std::make_pair(K, 2) };
-
-		for (auto order : orders) {
-			for (int i = 0; i < order.second; ++i) roster.push_back(playerFactory(order.first, (std::rand() % 4) + 1, startingPrestige));
-		}
-	}
+	void generateSpecialTeams() { addGeneratedPlayers({ std::make_pair(P, 2), std::make_pair(K, 2) }); }
 
 public:
 	Roster() {}
+	Roster(const Roster& other) : players(other.players), startingPrestige(other.startingPrestige) { relinkFrom(other); }
+	Roster(Roster&& other) noexcept = default;
 
-	Player* addPlayer(Player* player) {
-		roster.push_back(*player);
-		delete player;
-		return &roster.back();
+	Roster& operator=(const Roster& other) {
+		if (this == &other) return *this;
+		players = other.players;
+		startingPrestige = other.startingPrestige;
+		relinkFrom(other);
+		return *this;
 	}
+	Roster& operator=(Roster&& other) noexcept = default;
+
+	PlayerHandle addPlayer(Player player) {
+		PlayerHandle handle = players.emplace(std::move(player));
+		Player* added = players.get(handle);
+		added->setHandle(handle);
+		insertIntoBucket(added);
+		addToDepthChart(added);
+		return handle;
+	}
+
+	void removePlayer(PlayerHandle handle) {
+		Player* player = players.get(handle);
+		assert(player != nullptr);
+		removeFromBucket(player);
+		for (auto& chart : depthChart) chart.erase(std::remove(chart.begin(), chart.end(), player), chart.end());
+		players.remove(handle);
+	}
+
+	// Returns nullptr if the player has since left the roster
+	Player* getPlayer(PlayerHandle handle) { return players.get(handle); }
 
 	void advanceOneWeek() {
-		for (auto& player : roster) {
-			player.advanceOneWeek();
-		}
+		players.forEach([](Player& player) { player.advanceOneWeek(); });
 	}
 
 	void ageAndGraduatePlayers() {
-		for (int i = (int)roster.size() - 1; i >= 0; i--) {
-			bool graduated = roster[i].ageAndGraduate();
-			if (graduated) roster.erase(roster.begin() + i);
-		}
+		std::vector<PlayerHandle> graduates;
+		players.forEach([&](Player& player) {
+			if (player.ageAndGraduate()) graduates.push_back(player.getHandle());
+		});
+		for (PlayerHandle graduate : graduates) removePlayer(graduate);
 	}
 
 	void trainPlayersAtPosition(Position pos, double trainingMultiplier) {
-		for (Player* player : getAllPlayersAt(pos, false)) {
-			player->train(trainingMultiplier);
-		}
+		std::vector<Player*>& bucket = positionBuckets[pos];
+		Player::trainBatch(bucket.data(), bucket.size(), trainingMultiplier);
+		sortBucket(pos);
+	}
+
+	// Multipliers are indexed by Position
+	void trainAllPlayers(const std::array<double, 11>& trainingMultipliers) {
+		for (Position p : { QB, HB, WR, TE, OL, DL, LB, CB, S, K, P }) trainPlayersAtPosition(p, trainingMultipliers[p]);
 	}
 
 	void generateRoster(int prestige) {
@@ -124,28 +219,83 @@ public:
 		generateSpecialTeams();
 	}
 
-	std::vector<Player*> getAllPlayersAt(Position p, bool sorted = true, bool excludeInjured = false) {
-		std::vector<Player*> vec;
-		for (int i = 0; i < (int)roster.size(); ++i) {
-			if (roster[i].isInjured() && excludeInjured) continue;
-			if (roster[i].getPosition() == p) vec.push_back(&(roster[i]));
+	PositionView getAllPlayersAt(Position p) { return PositionView(&positionBuckets[p]); }
+
+	int getPositionCount(Position p) const { return positionBuckets[p].size(); }
+
+	// Changes whenever anything a game reads from the roster does: the depth chart's order, who's hurt, and each player's
+	// OVR and gametime bonus
+	size_t lineupFingerprint() const {
+		size_t hash = 0;
+		auto mix = [&hash](size_t value) { hash ^= value + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2); };
+		for (const auto& chart : depthChart) {
+			mix(chart.size());
+			for (const Player* player : chart) {
+				mix(player->getHandle().slot);
+				mix(player->getHandle().generation);
+				mix(player->isInjured());
+				mix(player->getOVR());
+				mix(std::hash<double>()(player->getGametimeBonus()));
+			}
 		}
-		if (sorted) {
-			SortByOVR sbr;
-			std::sort(vec.begin(), vec.end(), sbr);
+		return hash;
+	}
+
+	// Every player's weeks out, so a throwaway game's injuries can be undone with restoreInjuries
+	std::vector<int> saveInjuries() {
+		std::vector<int> weeks;
+		players.forEach([&](Player& player) { weeks.push_back(player.getWeeksInjured()); });
+		return weeks;
+	}
+
+	void restoreInjuries(const std::vector<int>& weeks) {
+		int i = 0;
+		players.forEach([&](Player& player) { player.setWeeksInjured(weeks[i++]); });
+	}
+
+	void applyInjuries(const std::vector<InjuryDelta>& injuries) {
+		for (const InjuryDelta& injury : injuries) {
+			Player* player = getPlayer(injury.player);
+			if (player != nullptr) player->setWeeksInjured(injury.weeks);
 		}
-		return vec;
 	}
 
-	std::vector<Player*> getElevenMen(const std::vector<Needs>& orders) {
+	// Every player, in the order saveState lists them
+	template<typename Func>
+	void forEachPlayer(Func func) { players.forEach(func); }
+
+	RosterState saveState() {
+		RosterState state{ saveInjuries(), {} };
+		players.forEach([&](Player& player) { state.gametimeBonuses.push_back(player.getGametimeBonus()); });
+		return state;
+	}
+
+	// Only for a roster with the same players as the one the state was saved from, like a copy made later in the season
+	void restoreState(const RosterState& state) {
+		restoreInjuries(state.weeksInjured);
+		int i = 0;
+		players.forEach([&](Player& player) { player.setGametimeBonus(state.gametimeBonuses[i++]); });
+	}
+
+	/**
+	 * Picks the healthiest top of the depth chart for each need, in order. The returned players line up with the
+	 * personnel, so the first personnel.needs[0].num players fill the first role, and so on.
+	 */
+	std::vector<Player*> getElevenMen(const Personnel& personnel) { return getElevenMen(depthChart, personnel); }
+
+	// The same pick from any depth chart laid out like a roster's, one chart per position
+	static std::vector<Player*> getElevenMen(const std::vector<std::vector<Player*>>& depthChart, const Personnel& personnel) {
 		std::vector<Player*> eleven;
 		std::unordered_set<Player*> elevenSet;
-		for (Needs order : orders) {
+		for (const Needs& order : personnel) {
+			const std::vector<Player*>& chart = depthChart[order.pos];
 			int playersFound = 0;
-			for (int i = 0; playersFound < order.num; ++i) { // TODO: find a way to not blow up if everyone's hurt!
-				Player* player = depthChart[order.pos][i];
-				if (player->isInjured()) continue;
-				eleven.push_back(depthChart[order.pos][i]);
+			for (int i = 0; playersFound < order.num; ++i) {
+				assert(i < (int)chart.size()); // Everyone's hurt!
+				Player* player = chart[i];
+				if (player->isInjured() || elevenSet.count(player)) continue;
+				eleven.push_back(player);
+				elevenSet.insert(player);
 				playersFound++;
 			}
 		}
@@ -154,24 +304,33 @@ public:
 	}
 
 	void organizeDepthChart() {
+		std::vector<Player*> all;
+		all.reserve(players.size());
+		players.forEach([&](Player& player) { all.push_back(&player); });
+		std::vector<std::vector<int>> outOfPositionOvrs = estimateOutOfPositionOvrs(all);
+
 		depthChart.clear();
+		std::vector<int> remainingPlayers;
 		for (Position p : { QB, HB, WR, TE, OL, DL, LB, CB, S, K, P }) {
-			std::vector<Player*> players = getAllPlayersAt(p);
-			std::vector<Player*> remainingPlayers;
-			for (auto& player : roster) {
-				if (player.getPosition() != p) remainingPlayers.push_back(&player);
+			PositionView bucket = getAllPlayersAt(p);
+			std::vector<Player*> chart(bucket.begin(), bucket.end());
+			remainingPlayers.clear();
+			for (int i = 0; i < (int)all.size(); i++) {
+				if (all[i]->getPosition() != p) remainingPlayers.push_back(i);
 			}
-			SortByOutOfPositionOvr sboopo(p);
-			std::sort(remainingPlayers.begin(), remainingPlayers.end(), sboopo);
-			for (auto player : remainingPlayers) players.push_back(player);
-			depthChart.push_back(players);
+			const std::vector<int>& keys = outOfPositionOvrs[p];
+			std::sort(remainingPlayers.begin(), remainingPlayers.end(), [&keys](int a, int b) { return keys[a] > keys[b]; });
+			for (int i : remainingPlayers) chart.push_back(all[i]);
+			depthChart.push_back(chart);
 		}
 	}
 
+	const std::vector<Player*>& getDepthChart(Position p) const { return depthChart[p]; }
+
 	std::pair<int, int> calcTotalOvrs() {
 		std::pair<int, int> totals = { 0, 0 };
 		for (Position p : { QB, HB, WR, TE, OL, DL, LB, CB, S }) {
-			std::vector<Player*> players = getAllPlayersAt(p);
+			PositionView players = getAllPlayersAt(p);
 			int starters = startingCount[p];
 			int positionTotal = 0;
 			for (int i = 0; i < starters; i++) {
@@ -187,7 +346,7 @@ public:
 	}
 
 	int getRosterSize() {
-		return roster.size();
+		return players.size();
 	}
 
 	void printRoster() {
@@ -195,26 +354,28 @@ public:
 		std::cout << "--------------------------------------------------------\n";
 		//            46. Jalen Edwards        QB  Sophomore  97 (+2) OUT 2wks
 		int num = 1;
-		for (auto& player : roster) {
-			std::printf("%2d. ", num);
-			player.printInfoLine();
-			++num;
+		for (auto& bucket : positionBuckets) {
+			for (Player* player : bucket) {
+				std::printf("%2d. ", num);
+				player->printInfoLine();
+				++num;
+			}
 		}
 	}
 
 	void printPositionGroup(Position pos) {
 		// We need to decide relevant statistics
-		std::vector<std::pair<Rating, int>> ratings = getRatingFactors(pos).first;
+		const RatingFactors& ratings = getRatingFactors(pos);
 		printf("Name                 Pos Year       OVR  ");
-		for (int i = 0; i < ratings.size(); i++) { printf("%-5s", ratingToStr(ratings[i].first).c_str()); }
+		for (const RatingFactor& rating : ratings) { printf("%-5s", ratingToStr(rating.rating).c_str()); }
 		printf("\n----------------------------------------");
-		for (int i = 0; i < ratings.size(); i++) printf("-----");
+		for (int i = 0; i < ratings.size; i++) printf("-----");
 		printf("\n");
 		int count = 0;
 		for (auto& player : depthChart[pos]) {
 			int ovr = player->getPosition() == pos ? player->getOVR() : estimateOutOfPositionOvr(player->getRatingsVector(), pos);
 			printf("%-21s%-4s%-11s%-5d", player->getName().c_str(), positionToStr(player->getPosition()).c_str(), player->getYearString().c_str(), ovr);
-			for (auto& rating : ratings) { printf("%-5d", player->getRating(rating.first, true)); }
+			for (const RatingFactor& rating : ratings) { printf("%-5d", player->getRating(rating.rating, true)); }
 			printf("\n");
 			count += 1;
 			if (count >= 20) break;
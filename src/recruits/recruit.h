@@ -1,5 +1,5 @@
 #pragma once
-#include "../players/player.h"
+#include "../players/roster.h"
 
 #define NUM_PREFS 5
 
@@ -18,6 +18,25 @@ const std::vector<std::pair<Position, int>> POSITION_DISTRIBUTION = {
 };
 const int TOTAL_POSITION_DISTRIBUTION = 70;
 
+// Each recruit's priorities are one of these rows, shuffled. Indexed by Recruit::Preference.
+const double PREFERENCE_WEIGHTS[6][NUM_PREFS] = {
+    {0.8, 0.2, 0, 0, 0},
+    {0.7, 0.1, 0.1, 0.1, 0},
+    {0.6, 0.3, 0.1, 0, 0},
+    {0.5, 0.25, 0.25, 0, 0},
+    {0.4, 0.2, 0.2, 0.2, 0},
+    {0.3, 0.2, 0.2, 0.2, 0.1}
+};
+
+int getPositionCapacity(Position pos) {
+    static const std::vector<int> capacities = [] {
+        std::vector<int> c(11, 0);
+        for (auto dist : POSITION_DISTRIBUTION) c[dist.first] = dist.second;
+        return c;
+    }();
+    return capacities[pos];
+}
+
 class Recruit {
 private:
 
@@ -37,7 +56,8 @@ public:
 
     Recruit() {}
 
-    Recruit(Position pos, int ovr) {
+    // The player is allocated from pool if one is given, otherwise with new
+    Recruit(Position pos, int ovr, SlotPool<Player>* pool = nullptr) {
         // Potential range: -10 - 30
         double potential = 0;
         double x = RNG::randomNumberUniformDist();
@@ -45,13 +65,14 @@ public:
         else if (x < 0.9) potential = 14 * x + 10;
         else potential = 30 * std::pow(x, 3) + 1;
 
-        player = new Player(playerFactory(pos, 1, 0, ovr, std::floor(potential) + ovr));
+        if (pool != nullptr) player = pool->get(pool->emplace(playerFactory(pos, 1, 0, ovr, std::floor(potential) + ovr)));
+        else
+            player = new Player(playerFactory(pos, 1, 0, ovr, std::floor(potential) + ovr));
 
         // Determine preferences
-        const std::vector<std::vector<double>> weights = { {0.8, 0.2, 0, 0, 0}, {0.7, 0.1, 0.1, 0.1, 0}, {0.6, 0.3, 0.1, 0, 0}, {0.5, 0.25, 0.25, 0, 0}, {0.4, 0.2, 0.2, 0.2, 0}, {0.3, 0.2, 0.2, 0.2, 0.1} };
-        std::vector<double> selection = *select_randomly(weights.begin(), weights.end());
-        RNG::shuffle(selection);
-        for (int i = 0; i < NUM_PREFS; i++) preferences[i] = selection[i];
+        const double* selection = *select_randomly(std::begin(PREFERENCE_WEIGHTS), std::end(PREFERENCE_WEIGHTS));
+        std::copy(selection, selection + NUM_PREFS, preferences);
+        std::shuffle(preferences, preferences + NUM_PREFS, RNG::gen);
     }
 
     Player* getUnderlyingPlayer() { return player; }
@@ -111,31 +132,35 @@ public:
         return str;
     }
 
-    double rateSchoolPreference(int prestige, City* city, int academics, int nfl, std::vector<Player*> others) {
+    // Position groups are sorted best-first, so stop at the first player we'd beat
+    int countBetterPlayers(const PositionView& others) {
+        int betterThanMe = 0;
+        for (Player* other : others) {
+            if (other->getOVR() < player->getOVR()) break;
+            betterThanMe++;
+        }
+        return betterThanMe;
+    }
+
+    // The score for a school at the given distance with the given number of better players ahead of us. Never goes down as
+    // either of them goes down, so plugging in lower bounds gives an upper bound on the score.
+    double rateSchool(int prestige, double distance, int academics, int nfl, int betterThanMe) {
         double score = 0.0;
         score += (prestige / 10.0) * preferences[PRESTIGE];
         score += ((300 - academics) / 299.0) * preferences[ACADEMICS];
         score += (nfl / 56.0) * preferences[NFL];
-        double dist = std::min(City::distance(city, player->getHometown()), 2500.0);
+        double dist = std::min(distance, 2500.0);
         score += ((2500 - dist) / 2500.0) * preferences[PROX_TO_HOME];
-
-        int betterThanMe = 0;
-        for (Player* other : others) {
-            if (other->getOVR() >= player->getOVR()) betterThanMe++;
-        }
-        int availableSpots;
-        for (int i = 0; i < (int)POSITION_DISTRIBUTION.size(); i++) {
-            if (POSITION_DISTRIBUTION[i].first == player->getPosition()) {
-                availableSpots = POSITION_DISTRIBUTION[i].second;
-                break;
-            }
-        }
-        if ((int)others.size() >= availableSpots) return -1;
+        int availableSpots = getPositionCapacity(player->getPosition());
         // Todo: consider scaling up the PLAY_TIME preference?
         score += ((availableSpots - betterThanMe) / (double)availableSpots) * (preferences[PLAY_TIME] + 0.25);
-
         return score;
     }
+
+    double rateSchoolPreference(int prestige, City* city, int academics, int nfl, const PositionView& others) {
+        if (others.size() >= getPositionCapacity(player->getPosition())) return -1;
+        return rateSchool(prestige, City::distance(city, player->getHometown()), academics, nfl, countBetterPlayers(others));
+    }
 };
 
 
@@ -148,7 +173,7 @@ public:
  * 1 star: 27-32 (6 pts)
  * 0 star: 20-26 (6 pts)
  */
-Recruit recruitFactory(double seedOverride = -1) {
+Recruit recruitFactory(double seedOverride = -1, SlotPool<Player>* pool = nullptr) {
     int positionSelection = RNG::randomNumberUniformDist(1, TOTAL_POSITION_DISTRIBUTION);
     Position p;
     for (auto dist : POSITION_DISTRIBUTION) {
@@ -169,6 +194,6 @@ Recruit recruitFactory(double seedOverride = -1) {
     else if (x < 0.9875) ovr = 41 + std::pow(21, std::pow(x, 5));
     else ovr = 55 + std::pow(21, std::pow(x, 80));
 
-    Recruit r(p, std::floor(ovr));
+    Recruit r(p, std::floor(ovr), pool);
     return r;
 }
\ No newline at end of file
@@ -1,85 +1,145 @@
 #pragma once
 #include "recruit.h"
+#include "schoolIndex.h"
 #include "../school.h"
 
-struct SortByRecruitOvr {
-    bool operator()(Recruit a, Recruit b) { return (a.getUnderlyingPlayer()->getOVR() > b.getUnderlyingPlayer()->getOVR()); }
-};
-
 struct TopRecruitingClass {
     Recruit recruits[10];
-    School* schoolChoices[10];
+    PlayerHandle players[10];
+    School* schoolChoices[10] = {};
 };
 
+// GREEDY lets each recruit pick their favorite school in OVR order, rescoring every school as rosters fill up.
+// STABLE_MATCHING runs deferred acceptance per position group against a snapshot of every school's roster (see
+// RecruitLounge::matchPositionGroup).
+enum class RecruitingMode { GREEDY, STABLE_MATCHING };
+
 class RecruitLounge {
 
+    RecruitingMode mode = RecruitingMode::GREEDY;
     std::vector<Recruit> recruits;
+    SlotPool<Player> prospects; // Where every recruit's player lives until they sign. Cleared for each new class
+    SchoolIndex schoolIndex; // Rebuilt for every signing day
+
+    /**
+     * Recruit-proposing deferred acceptance for one position group. Recruits rank schools by Recruit::rateSchoolPreference
+     * and the coaches' recruiting multiplier, and each school holds on to its best proposers by OVR, up to its open spots at
+     * the position. The multiplier covers a school's whole position group, so it shapes which schools a recruit goes after
+     * rather than how a school orders its recruits.
+     *
+     * Every school ranks recruits the same way, so proposing in OVR order means nobody who's held ever gets bumped: a school
+     * takes whoever proposes while it has room, and a full school turns everyone else down. So each recruit's preference
+     * list can be cut down to its top entry among the schools that still have room when their turn comes up, and once every
+     * school is full the rest of the group goes unsigned without being scored at all. Rosters don't change until the whole
+     * class is matched, so everyone is scored against the same snapshot.
+     *
+     * Returns each recruit's school, or nullptr if none of them had room.
+     */
+    std::vector<School*> matchPositionGroup(const std::vector<int>& group, std::vector<School*>& allSchools) {
+        Position pos = recruits[group[0]].getUnderlyingPlayer()->getPosition();
+        std::vector<int> openSpots(allSchools.size());
+        int schoolsWithRoom = 0;
+        for (int s = 0; s < (int)allSchools.size(); s++) {
+            Roster* roster = allSchools[s]->getRoster();
+            openSpots[s] = roster->getRosterSize() >= 70 ? 0 : std::max(0, getPositionCapacity(pos) - roster->getPositionCount(pos));
+            if (openSpots[s] > 0) schoolsWithRoom++;
+        }
+
+        std::vector<School*> choices(group.size(), nullptr);
+        for (int i = 0; i < (int)group.size() && schoolsWithRoom > 0; i++) {
+            int favorite = schoolIndex.findFavorite(recruits[group[i]], [&](int s) { return openSpots[s] > 0; });
+            if (favorite == -1) continue;
+            choices[i] = allSchools[favorite];
+            if (--openSpots[favorite] == 0) schoolsWithRoom--;
+        }
+        return choices;
+    }
 
 public:
     void generateNewRecruitingClass() {
         recruits.clear();
+        prospects.clear();
+        std::vector<Recruit> generated;
+        generated.reserve(3300);
         for (int i = 0; i < 2800; i++) {
-            recruits.push_back(recruitFactory());
+            generated.push_back(recruitFactory(-1, &prospects));
         }
         for (int i = 0; i < 500; i++) {
-            recruits.push_back(recruitFactory(RNG::randomNumberUniformDist(0.0, 0.05)));
+            generated.push_back(recruitFactory(RNG::randomNumberUniformDist(0.0, 0.05), &prospects));
         }
-        SortByRecruitOvr sbro;
-        std::sort(recruits.begin(), recruits.end(), sbro);
+        // Best first, and in the order they were generated among equals
+        std::vector<std::pair<int, int>> keys;
+        keys.reserve(generated.size());
+        for (int i = 0; i < (int)generated.size(); i++) keys.emplace_back(-generated[i].getUnderlyingPlayer()->getOVR(), i);
+        std::sort(keys.begin(), keys.end());
+        recruits.reserve(generated.size());
+        for (auto& key : keys) recruits.push_back(generated[key.second]);
     }
 
+    void setRecruitingMode(RecruitingMode m) { mode = m; }
+
+    // Expects schoolIndex to have been built over allSchools
     School* pickFavoriteSchool(std::vector<School*>& allSchools, int recruitIndex) {
-        double bestScore = -1;
-        School* favorite = nullptr;
         Recruit& recruit = recruits[recruitIndex];
-        for (School* school : allSchools) {
-            if (school->getRoster()->getRosterSize() >= 70) continue;
+        Position pos = recruit.getUnderlyingPlayer()->getPosition();
+        int index = schoolIndex.findFavorite(recruit, [&](int s) {
+            Roster* roster = allSchools[s]->getRoster();
+            return roster->getRosterSize() < 70 && roster->getPositionCount(pos) < getPositionCapacity(pos);
+        });
+        // If no one wanted him, his player just stays in the prospect pool. Sad :(
+        return index == -1 ? nullptr : allSchools[index];
+    }
 
-            int prestige = school->getPrestige();
-            int academics = school->getAcademicRating();
-            City* city = school->getCity();
-            int nfl = school->getNFLRating();
-            std::vector<Player*> others = school->getRoster()->getAllPlayersAt(recruit.getUnderlyingPlayer()->getPosition(), false);
-            int maxSpots;
-            for (auto dist : POSITION_DISTRIBUTION) if (dist.first == recruit.getUnderlyingPlayer()->getPosition()) maxSpots = dist.second;
-            if (others.size() >= maxSpots) continue;
-            double thisScore = recruit.rateSchoolPreference(prestige, city, academics, nfl, others);
-            double multiplier = school->getRecruitingMultiplier(recruit.getUnderlyingPlayer()->getPosition());
-            multiplier += (1 - multiplier) * 0.6;
-            thisScore *= multiplier;
-            if (thisScore > bestScore) {
-                favorite = school;
-                bestScore = thisScore;
-            }
-        }
-        if (favorite == nullptr) {
-            // No one wanted him. Sad :(
-            delete recruit.getUnderlyingPlayer();
+    void signRecruit(TopRecruitingClass& trc, int i, School* winner) {
+        int stars = recruits[i].getStars();
+        PlayerHandle newPlayer = winner->signRecruit(std::move(*recruits[i].getUnderlyingPlayer()), stars);
+        recruits[i].updateUnderlyingPlayer(nullptr);
+        if (i < 10) {
+            trc.recruits[i] = recruits[i];
+            trc.players[i] = newPlayer;
+            trc.schoolChoices[i] = winner;
         }
-        return favorite;
+    }
+
+    // Every recruit's school, or nullptr if they go unsigned. Position groups don't compete for spots, so they're matched
+    // side by side; nothing gets signed until they're all done.
+    std::vector<School*> matchRecruitingClass(std::vector<School*>& allSchools) {
+        std::vector<std::vector<int>> groups(11);
+        for (int i = 0; i < (int)recruits.size(); i++) groups[recruits[i].getUnderlyingPlayer()->getPosition()].push_back(i);
+        std::vector<School*> choices(recruits.size(), nullptr);
+        parallelFor(groups.size(), [&](int p) {
+            if (groups[p].empty()) return;
+            std::vector<School*> groupChoices = matchPositionGroup(groups[p], allSchools);
+            for (int i = 0; i < (int)groups[p].size(); i++) choices[groups[p][i]] = groupChoices[i];
+        });
+        return choices;
     }
 
     TopRecruitingClass signRecruitingClass(std::vector<School*>& allSchools) {
         TopRecruitingClass trc;
-        for (int i = 0; i < recruits.size(); i++) {
-            School* winner = pickFavoriteSchool(allSchools, i);
-            if (winner != nullptr) {
-                Player* newPlayer = winner->signRecruit(recruits[i].getUnderlyingPlayer(), recruits[i].getStars()); // this deletes the underlying player
-                if (i < 10) {
-                    trc.recruits[i] = recruits[i];
-                    trc.recruits[i].updateUnderlyingPlayer(newPlayer);
-                    trc.schoolChoices[i] = winner;
-                }
+        schoolIndex = SchoolIndex(allSchools);
+        if (mode == RecruitingMode::STABLE_MATCHING) {
+            std::vector<School*> choices = matchRecruitingClass(allSchools);
+            for (int i = 0; i < (int)recruits.size(); i++) {
+                if (choices[i] != nullptr) signRecruit(trc, i, choices[i]);
+            }
+        } else {
+            for (int i = 0; i < (int)recruits.size(); i++) {
+                School* winner = pickFavoriteSchool(allSchools, i);
+                if (winner != nullptr) signRecruit(trc, i, winner);
             }
         }
         int walkOnsNeeded = 0;
         for (auto& school : allSchools) {
             for (auto dist : POSITION_DISTRIBUTION) {
-                walkOnsNeeded += (dist.second - school->getRoster()->getAllPlayersAt(dist.first).size());
+                walkOnsNeeded += (dist.second - school->getRoster()->getPositionCount(dist.first));
                 // if (walkOnsNeeded > 500) std::cout << "SCHOOOOL: " << school->getName() << " - " << positionToStr(dist.first) << std::endl;
             }
         }
         std::cout << "WALK ONS NEEDED: " << walkOnsNeeded << std::endl;
         return trc;
     }
+
+    // What the latest signing day searched and scored
+    SchoolIndex& getSchoolIndex() { return schoolIndex; }
 };
\ No newline at end of file
@@ -0,0 +1,109 @@
+#pragma once
+#include "recruit.h"
+#include "../school.h"
+
+/**
+ * Finds a recruit's favorite school without fully scoring every school. Gives exactly the same answer as scoring each
+ * school in order and keeping the first one with the best score.
+ *
+ * A school's full score is only expensive because of the great-circle distance. Every school's location is stored as a
+ * point on the unit sphere, and the straight-line distance through the Earth to it is never more than the distance along
+ * the surface, so a few multiplications give an upper bound on each school's score. Schools are then visited best bound
+ * first, and the search stops once no bound can beat the best real score.
+ *
+ * Coaching staffs don't change during signing day, so the multipliers are snapshotted when the index is built. Counts are
+ * kept per position, so different position groups can be searched from different threads.
+ */
+class SchoolIndex {
+    struct SchoolFeatures {
+        School* school;
+        double x, y, z;
+        double multipliers[11]; // The recruiting multiplier at each position, as the recruit sees it
+    };
+
+    std::vector<SchoolFeatures> features;
+    long long searched[11] = {};
+    long long evaluated[11] = {};
+
+    static void toUnitVector(City* city, double& x, double& y, double& z) {
+        double lat = deg2rad(city->latitude);
+        double lon = deg2rad(city->longitude);
+        x = cos(lat) * cos(lon);
+        y = cos(lat) * sin(lon);
+        z = sin(lat);
+    }
+
+public:
+    SchoolIndex() {}
+    SchoolIndex(std::vector<School*>& allSchools) {
+        for (School* school : allSchools) {
+            SchoolFeatures f{ school, 0, 0, 0, {} };
+            toUnitVector(school->getCity(), f.x, f.y, f.z);
+            for (int p = 0; p < 11; p++) {
+                f.multipliers[p] = school->getRecruitingMultiplier((Position)p);
+                f.multipliers[p] += (1 - f.multipliers[p]) * 0.6;
+            }
+            features.push_back(f);
+        }
+    }
+
+    /**
+     * Index of the recruit's favorite school among the ones isOpen(index) says have room for them, or -1 if none do. Schools
+     * are indexed in the order they were given when building the index.
+     */
+    template<typename IsOpen>
+    int findFavorite(Recruit& recruit, IsOpen isOpen) {
+        Position pos = recruit.getUnderlyingPlayer()->getPosition();
+        double hx, hy, hz;
+        toUnitVector(recruit.getUnderlyingPlayer()->getHometown(), hx, hy, hz);
+
+        // Negated so that the heap hands out the best bound first, and the lowest index among equal bounds
+        std::vector<std::pair<double, int>> candidates;
+        candidates.reserve(features.size());
+        for (int s = 0; s < (int)features.size(); s++) {
+            if (!isOpen(s)) continue;
+            const SchoolFeatures& f = features[s];
+            double dx = f.x - hx, dy = f.y - hy, dz = f.z - hz;
+            // The extra kilometer covers any rounding in the distance calculations
+            double closest = std::max(0.0, earthRadiusKm * std::sqrt(dx * dx + dy * dy + dz * dz) - 1);
+            School* school = f.school;
+            double bound = recruit.rateSchool(school->getPrestige(), closest, school->getAcademicRating(), school->getNFLRating(),
+                recruit.countBetterPlayers(school->getRoster()->getAllPlayersAt(pos))) * f.multipliers[pos];
+            candidates.emplace_back(-bound, s);
+        }
+        searched[pos] += features.size();
+        auto worse = [](const std::pair<double, int>& a, const std::pair<double, int>& b) { return a > b; };
+        std::make_heap(candidates.begin(), candidates.end(), worse);
+
+        int favorite = -1;
+        double bestScore = -1;
+        while (!candidates.empty()) {
+            auto [negatedBound, s] = candidates.front();
+            if (-negatedBound < bestScore || (-negatedBound == bestScore && s > favorite)) break;
+            std::pop_heap(candidates.begin(), candidates.end(), worse);
+            candidates.pop_back();
+
+            evaluated[pos]++;
+            School* school = features[s].school;
+            double score = recruit.rateSchoolPreference(school->getPrestige(), school->getCity(), school->getAcademicRating(),
+                school->getNFLRating(), school->getRoster()->getAllPlayersAt(pos)) * features[s].multipliers[pos];
+            if (score > bestScore || (score == bestScore && s < favorite)) {
+                favorite = s;
+                bestScore = score;
+            }
+        }
+        return favorite;
+    }
+
+    // How many (recruit, school) pairs were searched, and how many of those needed their full score
+    long long getSearchedCount() {
+        long long total = 0;
+        for (long long c : searched) total += c;
+        return total;
+    }
+    long long getEvaluatedCount() {
+        long long total = 0;
+        for (long long e : evaluated) total += e;
+        return total;
+    }
+};
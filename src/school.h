@@ -2,6 +2,7 @@
 
 #include "coaches/coach.h"
 #include "coaches/coachlogs.h"
+#include "coaches/vacancyBoard.h"
 #include "players/roster.h"
 
 #include <iostream>
@@ -18,12 +19,25 @@ struct SortByAdjustedPublicOvr {
 	}
 };
 
+// What a coaching staff is worth to the players at each position. Coach ratings never change, so this only needs
+// recomputing when the staff does.
+struct CoachingEffects {
+	std::array<double, 11> development;
+	std::array<double, 11> recruiting;
+	std::array<double, 11> gametime;
+};
+
 class School {
 public:
 	struct Matchup {
 		School* away;
 		School* home;
 		GameResult gameResult;
+		// Enough to play a play-by-play game over exactly: where its RNG stream started, and both rosters at kickoff
+		bool replayable = false;
+		unsigned seed = 0;
+		RosterState awayKickoff;
+		RosterState homeKickoff;
 	};
 	struct NonConStrategy {
 		// outlines number of cupcake/quality/challenge games desired vs how many scheduled
@@ -115,6 +129,8 @@ private:
 	int defenseActualOvr = 0;
 
 	Coach* coaches[11];
+	CoachingEffects coachingEffects;
+	bool coachingEffectsStale = true; // Set whenever the staff changes
 	CoachingLogs coachLogs;
 	int recruitingClass[6];
 
@@ -214,9 +230,11 @@ public:
 		return m->gameResult.awayStats->points > m->gameResult.homeStats->points;
 	}
 	Matchup* getGameResults(int week) { return schedule[week]; }
-	std::pair<int, int> getWinLossRecord(bool confRecord = false) {
+	// Only the games before the given week count
+	std::pair<int, int> getWinLossRecord(bool confRecord = false, int weeks = 16) {
 		std::pair<int, int> winsLosses;
-		for (auto& game : schedule) {
+		for (int i = 0; i < weeks; i++) {
+			Matchup* game = schedule[i];
 			if (game != nullptr && game->gameResult.homeStats != nullptr) {
 				if (confRecord && game->away->getDivision() != game->home->getDivision() &&
 					game->away->getDivision() != getOppositeDivision(game->home->getDivision()))
@@ -259,13 +277,19 @@ public:
 		return (double)yards / games;
 	}
 
-	std::pair<double, double> getAverageOffenseDefense() {
-		// Make sure not to include postseason
-		TeamStats ts;
-		for (int i = 0; i < 13; i++) {
-			if (schedule[i] != nullptr) ts += *(getOrderedStats(getGameResults(i)).first);
+	std::pair<double, double> getAverageOffenseDefense(int weeks = 13) {
+		// Make sure not to include postseason. Only the team totals are needed, so there's no point merging box scores
+		int offensiveYards = 0;
+		int yardsAllowed = 0;
+		int games = TeamStats().games;
+		for (int i = 0; i < std::min(weeks, 13); i++) {
+			if (schedule[i] == nullptr || schedule[i]->gameResult.homeStats == nullptr) continue;
+			TeamStats* stats = getOrderedStats(schedule[i]).first;
+			offensiveYards += stats->offensiveYards();
+			yardsAllowed += stats->yardsAllowed;
+			games += stats->games;
 		}
-		return std::make_pair(ts.offensiveYards() / (double)ts.games, ts.yardsAllowed / (double)ts.games);
+		return std::make_pair(offensiveYards / (double)games, yardsAllowed / (double)games);
 	}
 
 	int getRanking() { return ranking; }
@@ -277,6 +301,7 @@ public:
 	void setDefenseRanking(int r) { defenseRanking = r; }
 	int getOffenseRanking() { return offenseRanking; }
 	int getDefenseRanking() { return defenseRanking; }
+	std::pair<int, int> getActualOvrs() { return std::make_pair(offenseActualOvr, defenseActualOvr); }
 	std::pair<int, int> setOverallOvrs() {
 		std::pair<int, int> ovrs = roster.calcTotalOvrs();
 		offenseTotalOvr = ovrs.first;
@@ -320,27 +345,52 @@ public:
 		return str;
 	}
 
-	Player* signRecruit(Player* player, int stars) {
+	PlayerHandle signRecruit(Player&& player, int stars) {
 		recruitingClass[stars]++;
-		return roster.addPlayer(player);
+		return roster.addPlayer(std::move(player));
+	}
+
+	// Needs a full staff. Called for every school once the carousel is done; anything else picks up changes lazily.
+	void refreshCoachingEffects() {
+		for (Position pos : { QB, HB, WR, TE, OL, DL, LB, CB, S, K, P }) {
+			Coach* hc = coaches[(int)CoachType::HC];
+			Coach* positional = coaches[(int)getPositionalCoachType(pos)];
+			Coach* secondLevel = coaches[(int)getSecondLevelCoachType(pos)];
+
+			double development = hc->getOvrDevelopment() - 40;
+			development += positional->getOvrDevelopment() - 40;
+			double recruiting = hc->getOvrRecruiting() - 40;
+			recruiting += positional->getOvrRecruiting() - 40;
+			if (pos == P || pos == K) {
+				coachingEffects.development[pos] = development / 118.0;
+				coachingEffects.recruiting[pos] = recruiting / 118.0;
+			} else {
+				development += secondLevel->getOvrDevelopment() - 40;
+				recruiting += secondLevel->getOvrRecruiting() - 40;
+				coachingEffects.development[pos] = development / 177.0;
+				coachingEffects.recruiting[pos] = recruiting / 177.0;
+			}
+
+			double gametime = positional->getOvrGametime();
+			bool specialTeams = getSecondLevelCoachType(pos) == CoachType::ST;
+			if (!specialTeams) gametime += secondLevel->getOvrGametime();
+			gametime += hc->getOvrGametime();
+			gametime -= (specialTeams ? 80 : 120);
+			gametime /= (59.0 * (specialTeams ? 2 : 3));
+			coachingEffects.gametime[pos] = gametime;
+		}
+		coachingEffectsStale = false;
 	}
 
-	double getRecruitingMultiplier(Position pos) {
-		double multiplier = coaches[(int)CoachType::HC]->getOvrRecruiting() - 40;
-		multiplier += coaches[(int)getPositionalCoachType(pos)]->getOvrRecruiting() - 40;
-		if (pos == P || pos == K) return multiplier / 118.0;
-		multiplier += coaches[(int)getSecondLevelCoachType(pos)]->getOvrRecruiting() - 40;
-		return multiplier / 177.0;
+	const CoachingEffects& getCoachingEffects() {
+		if (coachingEffectsStale) refreshCoachingEffects();
+		return coachingEffects;
 	}
 
+	double getRecruitingMultiplier(Position pos) { return getCoachingEffects().recruiting[pos]; }
+
 	// I think this is a number from 0 to 1? idk I don't remember writing this lol
-	double getDevelopmentMultiplier(Position pos) {
-		double multiplier = coaches[(int)CoachType::HC]->getOvrDevelopment() - 40;
-		multiplier += coaches[(int)getPositionalCoachType(pos)]->getOvrDevelopment() - 40;
-		if (pos == P || pos == K) return multiplier / 118.0;
-		multiplier += coaches[(int)getSecondLevelCoachType(pos)]->getOvrDevelopment() - 40;
-		return multiplier / 177.0;
-	}
+	double getDevelopmentMultiplier(Position pos) { return getCoachingEffects().development[pos]; }
 
 	void makeCoachingDecisions() {
 		Coach* coach = coaches[(int)CoachType::HC];
@@ -354,6 +404,7 @@ public:
 				coachLogs.recordFire(coaches[i], (CoachType)i);
 				coaches[i] = nullptr;
 			}
+			coachingEffectsStale = true;
 		} else {
 			if (coach->currentContract.yearsRemaining == 0) {
 				// Sign extension
@@ -369,6 +420,7 @@ public:
 
 	void signCoach(Coach* newCoach, CoachType type) {
 		coaches[(int)type] = newCoach;
+		coachingEffectsStale = true;
 		Contract contract;
 		int plusOne = (newCoach->getPublicOvr() > 90 ? 1 : 0);
 		contract.yearsTotal = (std::rand() % 2) + 3 + plusOne;
@@ -393,17 +445,28 @@ public:
 		coachLogs.recordHire(newCoach, type, contract.yearsTotal);
 	}
 
-	Coach* snipeCoach(std::vector<Coach*> snipeSet, std::vector<Vacancy>& competitors, int myVacancyIndex) {
-		// assume the first element of the vector is the coach who originally wanted to sign with us
+	// How this school ranks coaching candidates. The better the head coach, the better they see through public perception.
+	SortByAdjustedPublicOvr getCoachingTaste() {
 		Coach* hc = coaches[(int)CoachType::HC];
-		Coach* original = snipeSet[0]; // failsafe variable
-		if (hc == nullptr) return original;
-		double assessmentAbility = (hc->getActualOvr() - 40) / 59.0;
-		// Sort into our favorite coaches (yikes on efficiency)
-		SortByAdjustedPublicOvr sbao{ assessmentAbility };
-		std::sort(snipeSet.begin(), snipeSet.end(), sbao);
-		for (Coach* candidate : snipeSet) {
-			if (candidate->pickFavoriteJob(competitors) == myVacancyIndex) return candidate;
+		if (hc == nullptr) return SortByAdjustedPublicOvr{ 0 };
+		return SortByAdjustedPublicOvr{ (hc->getActualOvr() - 40) / 59.0 };
+	}
+
+	// The window holds the coach who originally wanted to sign with us, followed by the next coaches in line
+	Coach* snipeCoach(Coach* const* window, int windowSize, VacancyBoard& board, int myVacancy) {
+		Coach* original = window[0]; // failsafe variable
+		if (coaches[(int)CoachType::HC] == nullptr) return original;
+		// Go through our favorite coaches in order. Usually one of the first few bites, so pick them out one at a time
+		// rather than sorting the whole window
+		SortByAdjustedPublicOvr sbao = getCoachingTaste();
+		std::vector<bool> tried(windowSize, false);
+		for (int attempt = 0; attempt < windowSize; attempt++) {
+			int favorite = -1;
+			for (int i = 0; i < windowSize; i++) {
+				if (!tried[i] && (favorite == -1 || sbao(window[i], window[favorite]))) favorite = i;
+			}
+			tried[favorite] = true;
+			if (board.findFavorite(window[favorite]) == myVacancy) return window[favorite];
 		}
 		return original;
 	}
@@ -411,6 +474,13 @@ public:
 	void loseCoach(CoachType role) {
 		coachLogs.recordLoss(coaches[(int)role], role);
 		coaches[(int)role] = nullptr;
+		coachingEffectsStale = true;
+	}
+
+	void loseCoachToRetirement(CoachType role) {
+		coachLogs.recordRetirement(coaches[(int)role], role);
+		coaches[(int)role] = nullptr;
+		coachingEffectsStale = true;
 	}
 
 	std::pair<TeamStats*, TeamStats*> getOrderedStats(Matchup* m) {
@@ -458,21 +528,14 @@ public:
 	}
 
 	void applyGametimeBonuses() {
+		const CoachingEffects& effects = getCoachingEffects();
 		for (Position p : { QB, HB, WR, TE, OL, DL, LB, CB, S, K, P }) {
-			std::vector<Player*> players = roster.getAllPlayersAt(p, false);
-			for (Player* player : players) {
-				double bonus = coaches[(int)getPositionalCoachType(p)]->getOvrGametime();
-				CoachType t = getSecondLevelCoachType(p);
-				if (t != CoachType::ST) bonus += coaches[(int)t]->getOvrGametime();
-				bonus += coaches[(int)CoachType::HC]->getOvrGametime();
-				bonus -= (t == CoachType::ST ? 80 : 120);
-				bonus /= (59.0 * (t == CoachType::ST ? 2 : 3));
-				player->setGametimeBonus(bonus);
-			}
+			for (Player* player : roster.getAllPlayersAt(p)) player->setGametimeBonus(effects.gametime[p]);
 		}
 	}
 
 	bool isVacant(CoachType position) { return coaches[(int)position] == nullptr; }
+	Coach* getCoach(CoachType position) { return coaches[(int)position]; }
 
 	void printDetails() {
 		std::cout << "\n===== " << str_upper(getRankedName()) << " " << str_upper(getMascot()) << " =====\n";
@@ -525,8 +588,7 @@ public:
 	void advanceRosterOneYear() {
 		for (int i = 0; i < 6; i++) recruitingClass[i] = 0;
 		roster.ageAndGraduatePlayers();
-		for (Position p : {QB, HB, WR, OL, TE, DL, LB, CB, S, K, P})
-			roster.trainPlayersAtPosition(p, getDevelopmentMultiplier(p));
+		roster.trainAllPlayers(getCoachingEffects().development);
 	}
 	void prepareNextSeason() {
 		ranking = -1;
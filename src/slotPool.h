@@ -0,0 +1,117 @@
+#pragma once
+
+#include <cassert>
+#include <functional>
+#include <optional>
+#include <utility>
+#include <vector>
+
+/**
+ * Generation-checked reference to an object living in a SlotPool. Once the object is removed, the handle goes stale and
+ * resolves to nullptr, even if its slot has since been handed out to someone else.
+ */
+template<typename T>
+struct Handle {
+	int slot = -1;
+	int generation = 0;
+
+	bool isNull() const { return slot < 0; }
+	bool operator==(const Handle& other) const { return slot == other.slot && generation == other.generation; }
+	bool operator!=(const Handle& other) const { return !(*this == other); }
+};
+
+template<typename T>
+struct HandleHash {
+	size_t operator()(const Handle<T>& h) const { return std::hash<long long>()(((long long)h.generation << 32) | (unsigned int)h.slot); }
+};
+
+/**
+ * Pooled object storage with stable addresses. Objects are stored contiguously in fixed-size chunks that never move once
+ * allocated, so raw pointers stay valid for as long as the object is alive. Adding and removing are O(1): removed slots go
+ * on a free list to be recycled, and their generation is bumped so that outstanding handles can be detected as stale.
+ */
+template<typename T, int ChunkSize = 32>
+class SlotPool {
+	std::vector<std::vector<std::optional<T>>> chunks;
+	std::vector<int> generations;
+	std::vector<int> freeSlots;
+	int liveCount = 0;
+
+	std::optional<T>& at(int slot) { return chunks[slot / ChunkSize][slot % ChunkSize]; }
+	const std::optional<T>& at(int slot) const { return chunks[slot / ChunkSize][slot % ChunkSize]; }
+
+	void addChunk() {
+		int base = capacity();
+		chunks.emplace_back(ChunkSize);
+		generations.resize(base + ChunkSize, 0);
+		// Pushed in reverse so that slots get handed out in ascending order
+		for (int i = ChunkSize - 1; i >= 0; i--) freeSlots.push_back(base + i);
+	}
+
+public:
+	template<typename... Args>
+	Handle<T> emplace(Args&&... args) {
+		if (freeSlots.empty()) addChunk();
+		int slot = freeSlots.back();
+		freeSlots.pop_back();
+		at(slot).emplace(std::forward<Args>(args)...);
+		liveCount++;
+		return Handle<T>{ slot, generations[slot] };
+	}
+
+	void remove(Handle<T> h) {
+		assert(get(h) != nullptr);
+		at(h.slot).reset();
+		generations[h.slot]++;
+		freeSlots.push_back(h.slot);
+		liveCount--;
+	}
+
+	T* get(Handle<T> h) {
+		if (h.slot < 0 || h.slot >= capacity() || generations[h.slot] != h.generation || !at(h.slot)) return nullptr;
+		return &*at(h.slot);
+	}
+
+	const T* get(Handle<T> h) const {
+		if (h.slot < 0 || h.slot >= capacity() || generations[h.slot] != h.generation || !at(h.slot)) return nullptr;
+		return &*at(h.slot);
+	}
+
+	// Direct slot access, mostly for relinking pointers after a copy. Returns nullptr for empty slots.
+	T* getSlot(int slot) { return (slot >= 0 && slot < capacity() && at(slot)) ? &*at(slot) : nullptr; }
+	Handle<T> getHandle(int slot) const { return Handle<T>{ slot, generations[slot] }; }
+
+	// Removes everything but keeps the chunks allocated, so refilling the pool doesn't allocate again
+	void clear() {
+		freeSlots.clear();
+		for (int slot = capacity() - 1; slot >= 0; slot--) {
+			if (at(slot)) {
+				at(slot).reset();
+				generations[slot]++;
+			}
+			freeSlots.push_back(slot);
+		}
+		liveCount = 0;
+	}
+
+	int size() const { return liveCount; }
+	int capacity() const { return chunks.size() * ChunkSize; }
+
+	template<typename Func>
+	void forEach(Func func) {
+		for (auto& chunk : chunks) {
+			for (auto& item : chunk) {
+				if (item) func(*item);
+			}
+		}
+	}
+
+	template<typename Func>
+	void forEach(Func func) const {
+		for (auto& chunk : chunks) {
+			for (auto& item : chunk) {
+				if (item) func(*item);
+			}
+		}
+	}
+};
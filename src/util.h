@@ -1,11 +1,15 @@
 #pragma once
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <chrono>
+#include <future>
 #include <iterator>
 #include <random>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <vector>
 #include <math.h>
 #include <cmath> 
@@ -13,7 +17,7 @@
 class RNG {
 public:
 	static std::random_device rd;
-	static std::mt19937 gen;
+	static thread_local std::mt19937 gen; // Each thread draws from its own
 
 	// For automated testing only!!
 	static double resultOverride;
@@ -67,7 +71,7 @@ public:
 };
 
 std::random_device RNG::rd;
-std::mt19937 RNG::gen(RNG::rd());
+thread_local std::mt19937 RNG::gen(RNG::rd());
 double RNG::resultOverride(0.0);
 bool RNG::overrideSet(false);
 
@@ -85,7 +89,7 @@ Iter select_randomly(Iter start, Iter end, RandomGenerator& g) {
 template<typename Iter>
 Iter select_randomly(Iter start, Iter end) {
 	static std::random_device rd;
-	static std::mt19937 gen(rd());
+	static thread_local std::mt19937 gen(rd());
 	return select_randomly(start, end, gen);
 }
 
@@ -107,6 +111,135 @@ T pickMyPartner(const std::vector<std::pair<T, T>>& pairings, T me) {
 	return T();
 }
 
+/**
+ * Calls func(i) for every i in [0, count), spread across the machine's hardware threads. Work is handed out one index at
+ * a time, so uneven tasks still balance out. func must be safe to run concurrently for different indices.
+ */
+template<typename Func>
+void parallelFor(int count, Func func) {
+	int numThreads = std::min<int>(count, std::max(1u, std::thread::hardware_concurrency()));
+	if (numThreads <= 1) {
+		for (int i = 0; i < count; i++) func(i);
+		return;
+	}
+	std::atomic<int> next(0);
+	std::vector<std::thread> workers;
+	for (int t = 0; t < numThreads; t++) {
+		workers.emplace_back([&]() {
+			for (int i = next++; i < count; i = next++) func(i);
+		});
+	}
+	for (auto& worker : workers) worker.join();
+}
+
+/**
+ * Runs one job at a time off the calling thread, for work whose results aren't needed straight away. start() waits out
+ * the previous job first, so jobs still finish in the order they were started, and wait() is where anything that reads a
+ * job's results has to stop. Without a second hardware thread there's nothing to overlap with, so jobs just run in start().
+ */
+class BackgroundTask {
+	bool async;
+	std::future<void> running;
+
+public:
+	explicit BackgroundTask(bool runAsync = std::thread::hardware_concurrency() > 1) : async(runAsync) {}
+	BackgroundTask(const BackgroundTask&) = delete;
+	BackgroundTask& operator=(const BackgroundTask&) = delete;
+	~BackgroundTask() { wait(); }
+
+	template<typename Func>
+	void start(Func func) {
+		wait();
+		if (async) running = std::async(std::launch::async, func);
+		else
+			func();
+	}
+
+	// Rethrows anything the job threw
+	void wait() {
+		if (running.valid()) running.get();
+	}
+};
+
+/**
+ * Weighted draws without replacement. The weights sit in a Fenwick tree, so a draw and taking one out are both O(log n),
+ * and each draw picks among whoever's left in proportion to their weights, the same as re-rolling until someone who's
+ * still in comes up.
+ */
+class WeightedPicker {
+	std::vector<double> tree; // 1-based Fenwick tree of the weights still in
+	std::vector<double> weights;
+	int highestBit = 1;
+	int remaining = 0;
+
+	void add(int index, double amount) {
+		for (int i = index + 1; i < (int)tree.size(); i += i & -i) tree[i] += amount;
+	}
+
+public:
+	WeightedPicker(const std::vector<double>& w) : tree(w.size() + 1, 0.0), weights(w) {
+		for (int i = 0; i < (int)w.size(); i++) {
+			add(i, w[i]);
+			if (w[i] > 0) remaining++;
+		}
+		while (highestBit * 2 <= (int)w.size()) highestBit *= 2;
+	}
+
+	double total() const {
+		double sum = 0;
+		for (int i = (int)tree.size() - 1; i > 0; i -= i & -i) sum += tree[i];
+		return sum;
+	}
+
+	// How many are still in with a chance
+	int size() const { return remaining; }
+
+	// The index whose share of the total covers target, for target in [0, total())
+	int find(double target) const {
+		int index = 0;
+		for (int bit = highestBit; bit > 0; bit /= 2) {
+			if (index + bit < (int)tree.size() && tree[index + bit] <= target) {
+				index += bit;
+				target -= tree[index];
+			}
+		}
+		// Rounding can land just past the end or on someone already out, so settle on the nearest still in
+		index = std::min(index, (int)weights.size() - 1);
+		for (int i = index; i >= 0; i--) {
+			if (weights[i] > 0) return i;
+		}
+		for (int i = index + 1; i < (int)weights.size(); i++) {
+			if (weights[i] > 0) return i;
+		}
+		return index;
+	}
+
+	int draw() {
+		assert(remaining > 0);
+		return find(RNG::randomNumberUniformDist() * total());
+	}
+
+	void remove(int index) {
+		if (weights[index] <= 0) return;
+		add(index, -weights[index]);
+		weights[index] = 0;
+		remaining--;
+	}
+};
+
+// 95% Wilson score interval for the chance of something that happened hits times out of trials
+std::pair<double, double> wilsonInterval(int hits, int trials) {
+	const double z = 1.96;
+	double p = (double)hits / trials;
+	double centre = (p + z * z / (2 * trials)) / (1 + z * z / trials);
+	double halfWidth = z * std::sqrt(p * (1 - p) / trials + z * z / (4.0 * trials * trials)) / (1 + z * z / trials);
+	return std::make_pair(centre - halfWidth, centre + halfWidth);
+}
+
+double elapsedMs(std::chrono::steady_clock::time_point start) {
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
 std::string str_upper(std::string in) {
 	for (auto& c : in) c = toupper(c);
 	return in;
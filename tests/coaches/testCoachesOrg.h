@@ -0,0 +1,123 @@
+#pragma once
+#include <gtest/gtest.h>
+#include "../../src/coaches/coachesOrg.h"
+
+#include <map>
+
+class CoachesOrgTest : public ::testing::Test {
+protected:
+    City* city;
+    std::vector<School*> schools;
+    CoachesOrganization org;
+
+    void SetUp() override {
+        city = new City();
+        city->name = "Sample City";
+        city->state = "Sample State";
+        city->population = 10000;
+        for (int i = 0; i < 4; i++) {
+            std::string name = "S" + std::to_string(i);
+            schools.push_back(new School(name, "M" + std::to_string(i), name, city, 10, 25000, 1000000 * (i + 1), 20, 1));
+        }
+        for (int i = 0; i < 80; i++) org.generateCoach(true);
+        org.fillAllVacancies(schools);
+    }
+
+    void TearDown() override {
+        for (School* school : schools) delete school;
+        delete city;
+    }
+};
+
+TEST_F(CoachesOrgTest, PopulationStaysBoundedOverManySeasons) {
+    for (int year = 0; year < 150; year++) {
+        org.advanceYear();
+        org.fillAllVacancies(schools);
+        for (School* school : schools) {
+            for (int i = 0; i < 11; i++) ASSERT_FALSE(school->isVacant((CoachType)i));
+        }
+        // Every job, plus whoever has been unemployed for less than the cutoff
+        ASSERT_LE(org.getCoachCount(), 80 + 44);
+    }
+}
+
+TEST_F(CoachesOrgTest, RetiredCoachesLeaveThePool) {
+    std::vector<CoachHandle> handles;
+    std::vector<int> ages;
+    for (int i = 0; i < 80; i++) {
+        // Coaches were added in order, so the first 80 slots hold them all
+        CoachHandle h{ i, 0 };
+        ASSERT_NE(org.getCoach(h), nullptr);
+        handles.push_back(h);
+        ages.push_back(org.getCoach(h)->getAge());
+    }
+    for (int year = 0; year < COACH_RETIREMENT_AGE - 30; year++) {
+        org.advanceYear();
+        org.fillAllVacancies(schools);
+    }
+    for (int i = 0; i < 80; i++) {
+        // Everyone started at 30 or older, so they've all aged out by now, and their slots have been handed to new coaches
+        EXPECT_EQ(org.getCoach(handles[i]), nullptr) << "age " << ages[i];
+    }
+}
+
+TEST_F(CoachesOrgTest, MatchingModeKeepsEveryJobFilled) {
+    org.setHiringMode(HiringMode::STABLE_MATCHING);
+    for (int year = 0; year < 40; year++) {
+        org.advanceYear();
+        org.fillAllVacancies(schools);
+        for (School* school : schools) {
+            for (int i = 0; i < 11; i++) {
+                ASSERT_FALSE(school->isVacant((CoachType)i));
+                Coach* coach = school->getCoach((CoachType)i);
+                EXPECT_EQ(coach->getEmployer(), school);
+                EXPECT_EQ(coach->getJobType(), (CoachType)i);
+            }
+        }
+    }
+}
+
+TEST_F(CoachesOrgTest, MatchingHasNoBlockingPairs) {
+    std::vector<School*> fresh;
+    for (int i = 0; i < 6; i++) {
+        std::string name = "F" + std::to_string(i);
+        fresh.push_back(new School(name, name, name, city, 3 + i, 25000, 1500000 * (i + 1) + 300000 * (i % 2), 20, 1));
+    }
+    std::vector<Coach*> pool;
+    for (int i = 0; i < 60; i++) pool.push_back(new Coach(true));
+
+    HiringMatcher matcher;
+    std::vector<Vacancy> jobs;
+    for (School* school : fresh) {
+        for (int t = 0; t < 11; t++) {
+            int salary = (t == (int)CoachType::HC) ? school->getBudget() : school->getBudget() / 5;
+            jobs.push_back(Vacancy{ school, school->getName(), (CoachType)t, salary, school->getPrestige() });
+            matcher.addSeat(jobs.back());
+        }
+    }
+    for (Coach* coach : pool) matcher.addUnemployedCoach(coach);
+    matcher.run();
+
+    std::map<Coach*, Vacancy> assigned;
+    std::map<std::pair<School*, CoachType>, Coach*> holders;
+    for (auto& [coach, job] : matcher.getMoves()) {
+        EXPECT_TRUE(coach->canFill(job.type));
+        EXPECT_EQ(assigned.count(coach), 0);
+        assigned[coach] = job;
+        holders[{ job.school, job.type }] = coach;
+    }
+    EXPECT_GT(assigned.size(), 0u);
+    EXPECT_EQ(assigned.size() + matcher.getOpenJobs().size(), jobs.size());
+    for (Coach* coach : pool) {
+        double current = assigned.count(coach) ? coach->getPreferenceLevel(assigned[coach]) : -1000000;
+        for (const Vacancy& job : jobs) {
+            if (!coach->canFill(job.type) || coach->getPreferenceLevel(job) <= current) continue;
+            // The coach would rather be here, so the school has to be happier with who it got
+            auto it = holders.find({ job.school, job.type });
+            ASSERT_NE(it, holders.end());
+            EXPECT_FALSE(job.school->getCoachingTaste()(coach, it->second));
+        }
+    }
+    for (Coach* coach : pool) delete coach;
+    for (School* school : fresh) delete school;
+}
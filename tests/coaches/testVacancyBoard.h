@@ -0,0 +1,55 @@
+#pragma once
+#include <gtest/gtest.h>
+#include "../../src/coaches/vacancyBoard.h"
+
+class VacancyBoardTest : public ::testing::Test {
+protected:
+    // Only used as identities, never dereferenced
+    School* schools[6] = { (School*)0x10, (School*)0x20, (School*)0x30, (School*)0x40, (School*)0x50, (School*)0x60 };
+
+    Vacancy makeVacancy(int s, CoachType type, int salary, int prestige) {
+        return Vacancy{ schools[s], "School " + std::to_string(s), type, salary, prestige };
+    }
+};
+
+TEST_F(VacancyBoardTest, FavoriteMatchesLinearScan) {
+    srand(7);
+    std::vector<Vacancy> list;
+    VacancyBoard board;
+    for (int i = 0; i < 120; i++) {
+        // Lots of salary and prestige ties to exercise the tie-breaks
+        Vacancy v = makeVacancy(i % 6, (CoachType)(std::rand() % 11), (1 + std::rand() % 8) * 1000000 + std::rand() % 1000, 6 + std::rand() % 5);
+        list.push_back(v);
+        board.add(v);
+    }
+    std::vector<int> ids(list.size());
+    for (int i = 0; i < (int)ids.size(); i++) ids[i] = i;
+
+    for (int round = 0; round < 60; round++) {
+        Coach coach(false);
+        if (round % 2 == 0) {
+            // Employed coaches get a stability bonus at their current school
+            coach.takeJob(makeVacancy(round % 6, CoachType::QB, 500000, 5));
+            for (int y = 0; y < 1 + round % 3; y++) coach.incrementYear();
+        }
+        int linear = coach.pickFavoriteJob(list);
+        int indexed = board.findFavorite(&coach);
+        ASSERT_EQ(indexed, linear == -1 ? -1 : ids[linear]);
+        if (linear != -1) {
+            board.fill(ids[linear]);
+            list.erase(list.begin() + linear);
+            ids.erase(ids.begin() + linear);
+        }
+    }
+    EXPECT_EQ(board.size(), (int)list.size());
+}
+
+TEST_F(VacancyBoardTest, FirstYearCoachesStayPut) {
+    VacancyBoard board;
+    board.add(makeVacancy(0, CoachType::HC, 50000000, 10));
+    Coach coach(false);
+    coach.takeJob(makeVacancy(1, CoachType::QB, 1000000, 5));
+    EXPECT_EQ(board.findFavorite(&coach), -1);
+    coach.incrementYear();
+    EXPECT_EQ(board.findFavorite(&coach), 0);
+}
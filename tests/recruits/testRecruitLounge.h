@@ -0,0 +1,67 @@
+#pragma once
+#include <gtest/gtest.h>
+#include "../../src/recruits/recruitLounge.h"
+
+class RecruitLoungeTest : public ::testing::Test {
+protected:
+    std::vector<School*> schools;
+
+    void SetUp() override {
+        for (int i = 0; i < 5; i++) {
+            std::string name = "S" + std::to_string(i);
+            School* school = new School(name, name, name, GlobalData::getRandomCity(), 2 * i + 1, 25000, 1000000, 20, 1);
+            for (int t = 0; t < 11; t++) school->signCoach(new Coach(false, (CoachType)t), (CoachType)t);
+            school->getRoster()->ageAndGraduatePlayers();
+            schools.push_back(school);
+        }
+    }
+
+    void TearDown() override {
+        for (School* school : schools) {
+            for (int t = 0; t < 11; t++) delete school->getCoach((CoachType)t);
+            delete school;
+        }
+    }
+};
+
+TEST_F(RecruitLoungeTest, MatchingFillsEveryPositionToCapacity) {
+    RecruitLounge lounge;
+    lounge.setRecruitingMode(RecruitingMode::STABLE_MATCHING);
+    lounge.generateNewRecruitingClass();
+    TopRecruitingClass trc = lounge.signRecruitingClass(schools);
+    for (School* school : schools) {
+        // Way more recruits than open spots, so everyone fills up
+        EXPECT_EQ(school->getRoster()->getRosterSize(), 70);
+        for (auto dist : POSITION_DISTRIBUTION) EXPECT_EQ(school->getRoster()->getPositionCount(dist.first), dist.second);
+    }
+    // Nobody turns down the best recruit in the class
+    ASSERT_NE(trc.schoolChoices[0], nullptr);
+    EXPECT_NE(trc.schoolChoices[0]->getRoster()->getPlayer(trc.players[0]), nullptr);
+}
+
+TEST_F(RecruitLoungeTest, IndexPicksTheSameFavoriteAsScoringEverySchool) {
+    SchoolIndex index(schools);
+    for (int i = 0; i < 200; i++) {
+        Recruit recruit = recruitFactory();
+        Position pos = recruit.getUnderlyingPlayer()->getPosition();
+        auto isOpen = [&](int s) { return (s + i) % 4 != 0; };
+        int expected = -1;
+        double bestScore = -1;
+        for (int s = 0; s < (int)schools.size(); s++) {
+            if (!isOpen(s)) continue;
+            School* school = schools[s];
+            double multiplier = school->getRecruitingMultiplier(pos);
+            multiplier += (1 - multiplier) * 0.6;
+            double score = recruit.rateSchoolPreference(school->getPrestige(), school->getCity(), school->getAcademicRating(),
+                school->getNFLRating(), school->getRoster()->getAllPlayersAt(pos)) * multiplier;
+            if (score > bestScore) {
+                expected = s;
+                bestScore = score;
+            }
+        }
+        EXPECT_EQ(index.findFavorite(recruit, isOpen), expected);
+        delete recruit.getUnderlyingPlayer();
+    }
+    EXPECT_EQ(index.getSearchedCount(), 200 * (long long)schools.size());
+    EXPECT_LE(index.getEvaluatedCount(), index.getSearchedCount());
+}
@@ -10,6 +10,7 @@ TEST(RecruitTestSuite, FactoryPositionAssignment) {
     RNG::setRngOverride(69);
     Recruit r2 = recruitFactory();
     EXPECT_EQ(r2.getUnderlyingPlayer()->getPosition(), K);
+    RNG::overrideSet = false;
 }
 
 TEST(RecruitTestSuite, FactoryOvrAssignment) {
@@ -29,4 +30,5 @@ TEST(RecruitTestSuite, ConstructorPotentialAssignment) {
         r1.getUnderlyingPlayer()->train(0.75);
     }
     EXPECT_EQ(r1.getUnderlyingPlayer()->getOVR(), 81);
+    RNG::overrideSet = false;
 }
\ No newline at end of file
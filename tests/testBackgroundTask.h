@@ -0,0 +1,25 @@
+#pragma once
+#include <gtest/gtest.h>
+#include "../src/util.h"
+
+TEST(BackgroundTaskTest, JobsFinishInTheOrderTheyStarted) {
+    for (bool async : { true, false }) {
+        BackgroundTask task(async);
+        std::vector<int> finished;
+        for (int i = 0; i < 5; i++) {
+            task.start([&finished, i]() {
+                std::this_thread::sleep_for(std::chrono::milliseconds(5 - i));
+                finished.push_back(i);
+            });
+        }
+        task.wait();
+        EXPECT_EQ(finished, std::vector<int>({ 0, 1, 2, 3, 4 }));
+    }
+}
+
+TEST(BackgroundTaskTest, WaitRethrowsWhatTheJobThrew) {
+    BackgroundTask task(true);
+    task.start([]() { throw std::string("no standings"); });
+    EXPECT_THROW(task.wait(), std::string);
+    task.wait(); // Nothing left to wait for
+}
@@ -0,0 +1,42 @@
+#pragma once
+#include <gtest/gtest.h>
+#include "../src/games/fastGamePlayer.h"
+#include "twoSchoolTest.h"
+
+class FastGamePlayerTest : public TwoSchoolTest {};
+
+TEST_F(FastGamePlayerTest, BoxScoreAddsUpToThePoints) {
+    FastSimModel model = FastSimModel::defaults();
+    RNG::gen.seed(5);
+    for (int i = 0; i < 50; i++) {
+        GameResult result = FastGamePlayer(schools[0], schools[1], model).play();
+        for (TeamStats* stats : { result.awayStats, result.homeStats }) {
+            EXPECT_EQ(stats->points, 7 * (stats->rushingTDs() + stats->passingTDs()) + 3 * stats->FGsMade());
+            EXPECT_LE(stats->completions(), stats->passAttempts());
+        }
+        EXPECT_EQ(result.awayStats->yardsAllowed, result.homeStats->offensiveYards());
+        EXPECT_EQ(result.homeWon, result.homeStats->points > result.awayStats->points);
+        delete result.awayStats;
+        delete result.homeStats;
+    }
+}
+
+TEST_F(FastGamePlayerTest, FitRecoversTheFullEngineAverages) {
+    std::vector<int> injuries = schools[0]->getRoster()->saveInjuries();
+    std::vector<std::pair<School*, School*>> pairs(40, { schools[0], schools[1] });
+    std::vector<EngineSample> samples = FastSimModel::sampleFullEngine(pairs, 3);
+    FastSimModel model = FastSimModel::fit(samples);
+    // Least squares goes through the mean of every stat
+    for (int s = 0; s < NUM_FAST_STATS; s++) {
+        double actual = 0, predicted = 0;
+        for (const EngineSample& sample : samples) {
+            for (int side = 0; side < 2; side++) {
+                actual += sample.stats[side][s];
+                predicted += model.expected((FastStat)s, sample.ratings[side], sample.ratings[1 - side]);
+            }
+        }
+        EXPECT_NEAR(actual, predicted, 1e-6 * std::max(1.0, std::abs(actual))) << FAST_STAT_NAMES[s];
+    }
+    // Samples came from copies, so the real rosters are untouched
+    EXPECT_EQ(schools[0]->getRoster()->saveInjuries(), injuries);
+}
@@ -0,0 +1,60 @@
+#pragma once
+#include <gtest/gtest.h>
+#include "../src/games/gamePlayer.h"
+#include "twoSchoolTest.h"
+
+class GameReplayTest : public TwoSchoolTest {};
+
+TEST_F(GameReplayTest, SeedAndKickoffStatePlayTheSameGame) {
+    RosterState awayKickoff = schools[0]->getRoster()->saveState();
+    RosterState homeKickoff = schools[1]->getRoster()->saveState();
+    std::vector<PlayRecord> original, replayed;
+
+    testing::internal::CaptureStdout();
+    GamePlayer game(schools[0], schools[1]);
+    game.logPlaysTo(&original);
+    GameResult first = game.startSeededGameLoop(77, false);
+    EXPECT_EQ(testing::internal::GetCapturedStdout(), "");
+    schools[0]->getRoster()->applyInjuries(first.awayInjuries);
+    schools[1]->getRoster()->applyInjuries(first.homeInjuries);
+
+    // Some other games in between move the RNG on and hurt people
+    for (int i = 0; i < 3; i++) {
+        GameResult other = GamePlayer(schools[1], schools[0]).startRealTimeGameLoop(false);
+        schools[1]->getRoster()->applyInjuries(other.awayInjuries);
+        schools[0]->getRoster()->applyInjuries(other.homeInjuries);
+        delete other.awayStats;
+        delete other.homeStats;
+    }
+    RosterState awayNow = schools[0]->getRoster()->saveState();
+
+    TeamSnapshot awaySnapshot(schools[0]->getRoster(), &awayKickoff);
+    TeamSnapshot homeSnapshot(schools[1]->getRoster(), &homeKickoff);
+    GamePlayer replay(schools[0], schools[1], &awaySnapshot, &homeSnapshot, new TeamStats(), new TeamStats());
+    replay.logPlaysTo(&replayed);
+    testing::internal::CaptureStdout();
+    GameResult second = replay.startSeededGameLoop(77, true);
+    std::string text = testing::internal::GetCapturedStdout();
+
+    EXPECT_NE(text.find("GAME OVER"), std::string::npos);
+    EXPECT_EQ(first.awayStats->points, second.awayStats->points);
+    EXPECT_EQ(first.homeStats->points, second.homeStats->points);
+    EXPECT_EQ(first.awayStats->offensiveYards(), second.awayStats->offensiveYards());
+    ASSERT_EQ(original.size(), replayed.size());
+    EXPECT_EQ(std::memcmp(original.data(), replayed.data(), original.size() * sizeof(PlayRecord)), 0);
+    // The replay hurts the same players as the original, and none of it reaches the real roster
+    auto sameInjuries = [](const std::vector<InjuryDelta>& a, const std::vector<InjuryDelta>& b) {
+        ASSERT_EQ(a.size(), b.size());
+        for (size_t i = 0; i < a.size(); i++) {
+            EXPECT_TRUE(a[i].player == b[i].player);
+            EXPECT_EQ(a[i].weeks, b[i].weeks);
+        }
+    };
+    sameInjuries(first.awayInjuries, second.awayInjuries);
+    sameInjuries(first.homeInjuries, second.homeInjuries);
+    EXPECT_EQ(schools[0]->getRoster()->saveInjuries(), awayNow.weeksInjured);
+    for (GameResult* result : { &first, &second }) {
+        delete result->awayStats;
+        delete result->homeStats;
+    }
+}
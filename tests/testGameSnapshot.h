@@ -0,0 +1,52 @@
+#pragma once
+#include <gtest/gtest.h>
+#include "../src/games/gamePlayer.h"
+#include "twoSchoolTest.h"
+
+class GameSnapshotTest : public TwoSchoolTest {};
+
+TEST_F(GameSnapshotTest, GamesOnlyHurtTheRealTeamWhenTheirInjuriesAreApplied) {
+    RNG::gen.seed(8);
+    std::vector<int> before[2] = { schools[0]->getRoster()->saveInjuries(), schools[1]->getRoster()->saveInjuries() };
+    GameResult result;
+    // Enough games that someone's bound to get hurt in one of them
+    for (int i = 0; i < 20 && result.awayInjuries.empty() && result.homeInjuries.empty(); i++) {
+        delete result.awayStats;
+        delete result.homeStats;
+        result = GamePlayer(schools[0], schools[1]).startRealTimeGameLoop(false);
+        EXPECT_EQ(schools[0]->getRoster()->saveInjuries(), before[0]);
+        EXPECT_EQ(schools[1]->getRoster()->saveInjuries(), before[1]);
+    }
+    ASSERT_FALSE(result.awayInjuries.empty() && result.homeInjuries.empty());
+    EXPECT_EQ(result.awayStats->roster, schools[0]->getRoster());
+
+    Roster* rosters[2] = { schools[0]->getRoster(), schools[1]->getRoster() };
+    const std::vector<InjuryDelta>* deltas[2] = { &result.awayInjuries, &result.homeInjuries };
+    for (int s = 0; s < 2; s++) {
+        rosters[s]->applyInjuries(*deltas[s]);
+        for (const InjuryDelta& injury : *deltas[s]) {
+            EXPECT_NE(injury.weeks, 0); // -1 is out for the season
+            EXPECT_EQ(rosters[s]->getPlayer(injury.player)->getWeeksInjured(), injury.weeks);
+        }
+    }
+    delete result.awayStats;
+    delete result.homeStats;
+}
+
+TEST_F(GameSnapshotTest, ResetPutsEveryoneBackTheWayTheyWereAtKickoff) {
+    RNG::gen.seed(9);
+    TeamSnapshot away(schools[0]->getRoster());
+    TeamSnapshot home(schools[1]->getRoster());
+    TeamStats awayStats, homeStats;
+    for (int i = 0; i < 5; i++) {
+        away.reset();
+        home.reset();
+        awayStats.clearForReuse();
+        homeStats.clearForReuse();
+        GamePlayer(schools[0], schools[1], &away, &home, &awayStats, &homeStats).startRealTimeGameLoop(false);
+    }
+    away.reset();
+    home.reset();
+    EXPECT_TRUE(away.injuries().empty());
+    EXPECT_TRUE(home.injuries().empty());
+}
@@ -0,0 +1,57 @@
+#pragma once
+#include <gtest/gtest.h>
+#include "../src/games/matchupSimulator.h"
+#include "twoSchoolTest.h"
+
+class LockstepGamesTest : public TwoSchoolTest {
+protected:
+    School* strong;
+    School* weak;
+
+    void SetUp() override {
+        TwoSchoolTest::SetUp();
+        strong = schools[1];
+        weak = schools[0];
+    }
+};
+
+TEST_F(LockstepGamesTest, BatchedYardsMatchTheScalarCurves) {
+    const int n = 1000;
+    std::vector<double> x(n), advantage(n, 12.5);
+    std::vector<int> run(n), pass(n);
+    for (int i = 0; i < n; i++) x[i] = (i + 0.5) / n;
+    NumberMaker::getRunYardsGained(x.data(), advantage.data(), run.data(), n);
+    NumberMaker::getPassYardsGained(x.data(), pass.data(), n);
+    for (int i = 0; i < n; i++) {
+        EXPECT_EQ(run[i], (int)std::round(NumberMaker::runYardsCurve(x[i], 12.5))) << x[i];
+        EXPECT_EQ(pass[i], (int)std::round(NumberMaker::passYardsCurve(x[i]))) << x[i];
+    }
+}
+
+TEST_F(LockstepGamesTest, SameSeedSameGamesAndTheRostersAreLeftAlone) {
+    std::vector<int> injuries = strong->getRoster()->saveInjuries();
+    LockstepGames games(strong->getRoster(), weak->getRoster(), 4, 200);
+    EXPECT_EQ(strong->getRoster()->saveInjuries(), injuries);
+
+    int away[LockstepGames::LANES], home[LockstepGames::LANES];
+    int againAway[LockstepGames::LANES], againHome[LockstepGames::LANES];
+    games.play(away, home);
+    games.reseed(4);
+    games.play(againAway, againHome);
+    for (int l = 0; l < LockstepGames::LANES; l++) {
+        EXPECT_EQ(away[l], againAway[l]);
+        EXPECT_EQ(home[l], againHome[l]);
+        EXPECT_GE(away[l], 0);
+        EXPECT_GE(home[l], 0);
+    }
+    const LockstepSide& side = games.getSide(false);
+    EXPECT_GT(side.completionChance, 0);
+    EXPECT_LE(side.sackChance + side.interceptionChance + side.completionChance, 1.0);
+}
+
+TEST_F(LockstepGamesTest, MatchupSimulatorPlaysExactlyTheGamesAskedFor) {
+    MatchupOdds odds = MatchupSimulator(strong, weak).runLockstep(250, 0, 1);
+    EXPECT_EQ(odds.games, 250);
+    EXPECT_EQ(odds.awayWins + odds.homeWins + odds.ties, 250);
+    EXPECT_GT(odds.awayWins, odds.homeWins);
+}
@@ -1,8 +1,24 @@
 #include <gtest/gtest.h>
 #include "testPlayer.h"
+#include "testRoster.h"
 #include "testSchool.h"
 #include "testGameManager.h"
+#include "testPlayLog.h"
+#include "testGameReplay.h"
+#include "testGameSnapshot.h"
+#include "testNumberMaker.h"
+#include "testWeightedPicker.h"
+#include "testBackgroundTask.h"
+#include "testMatchupSimulator.h"
+#include "testLockstepGames.h"
+#include "testWinProbabilityMatrix.h"
+#include "testFastGamePlayer.h"
+#include "testRankingEngine.h"
+#include "testPlayoffProjector.h"
 #include "recruits/testRecruits.h"
+#include "recruits/testRecruitLounge.h"
+#include "coaches/testVacancyBoard.h"
+#include "coaches/testCoachesOrg.h"
 #include "../src/loadData.h"
 
 int main(int argc, char** argv) {
@@ -0,0 +1,51 @@
+#pragma once
+#include <gtest/gtest.h>
+#include "../src/games/matchupSimulator.h"
+#include "twoSchoolTest.h"
+
+class MatchupSimulatorTest : public TwoSchoolTest {
+protected:
+    School* away;
+    School* home;
+
+    void SetUp() override {
+        TwoSchoolTest::SetUp();
+        away = schools[1];
+        home = schools[0];
+    }
+};
+
+TEST_F(MatchupSimulatorTest, ReplaysLeaveTheRealRostersAlone) {
+    std::vector<int> awayInjuries = away->getRoster()->saveInjuries();
+    std::vector<int> homeInjuries = home->getRoster()->saveInjuries();
+    MatchupOdds odds = MatchupSimulator(away, home).run(60, 0, 1);
+    EXPECT_EQ(away->getRoster()->saveInjuries(), awayInjuries);
+    EXPECT_EQ(home->getRoster()->saveInjuries(), homeInjuries);
+
+    EXPECT_EQ(odds.games, 60);
+    EXPECT_EQ(odds.awayWins + odds.homeWins + odds.ties, 60);
+    EXPECT_EQ(odds.awayStats.games, 60);
+    EXPECT_EQ(odds.awayStats.points, odds.awayPoints);
+    EXPECT_EQ(odds.homeStats.points, odds.homePoints);
+    int margins = 0;
+    for (int count : odds.margins) margins += count;
+    EXPECT_EQ(margins, 60);
+}
+
+TEST_F(MatchupSimulatorTest, StopsOnceTheIntervalIsNarrowEnough) {
+    MatchupOdds odds = MatchupSimulator(away, home).run(5000, 0.4, 1);
+    EXPECT_LT(odds.games, 5000);
+    EXPECT_LT(odds.intervalWidth(), 0.4);
+}
+
+TEST_F(MatchupSimulatorTest, ClearedStatsKeepTheirPlayers) {
+    TeamStats stats;
+    Player* qb = *away->getRoster()->getAllPlayersAt(QB).begin();
+    stats.points = 21;
+    stats.recordRush(qb, 12);
+    stats.clearForReuse();
+    EXPECT_EQ(stats.points, 0);
+    EXPECT_EQ(stats.players.size(), 1u);
+    EXPECT_EQ(stats.rushingYards(), 0);
+    EXPECT_EQ(stats.games, 1);
+}
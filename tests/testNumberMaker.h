@@ -0,0 +1,61 @@
+#pragma once
+#include <gtest/gtest.h>
+#include "../src/games/numberMaker.h"
+
+#include <map>
+
+// How often each rounded yardage comes up when curve(x) is evaluated at n evenly spread x's
+template<class Curve>
+std::map<int, double> analyticYards(Curve curve, int n = 200000) {
+    std::map<int, double> pmf;
+    for (int i = 0; i < n; i++) pmf[(int)std::round(curve((i + 0.5) / n))] += 1.0 / n;
+    return pmf;
+}
+
+std::map<int, double> sampledYards(std::function<int()> draw, int n = 200000) {
+    std::map<int, double> pmf;
+    for (int i = 0; i < n; i++) pmf[draw()] += 1.0 / n;
+    return pmf;
+}
+
+double totalVariation(const std::map<int, double>& a, const std::map<int, double>& b) {
+    std::map<int, double> gap = a;
+    for (auto& [yards, p] : b) gap[yards] -= p;
+    double total = 0;
+    for (auto& [yards, p] : gap) total += std::abs(p);
+    return total / 2;
+}
+
+TEST(NumberMakerTest, PassTableIsTheCurveRounded) {
+    RNG::gen.seed(3);
+    std::map<int, double> analytic = analyticYards(NumberMaker::passYardsCurve);
+    std::map<int, double> sampled = sampledYards([] { return NumberMaker::getPassYardsGained(); });
+    EXPECT_LT(totalVariation(analytic, sampled), 0.01);
+}
+
+TEST(NumberMakerTest, RunTableShiftsWithTheAdvantage) {
+    RNG::gen.seed(4);
+    for (double advantage : { -30.0, 0.0, 12.0, 25.4 }) {
+        std::map<int, double> analytic = analyticYards([=](double x) { return NumberMaker::runYardsCurve(x, advantage); });
+        std::map<int, double> sampled = sampledYards([=] { return NumberMaker::getRunYardsGained(advantage); });
+        EXPECT_LT(totalVariation(analytic, sampled), 0.015) << advantage;
+        double analyticMean = 0, sampledMean = 0;
+        for (auto& [yards, p] : analytic) analyticMean += yards * p;
+        for (auto& [yards, p] : sampled) sampledMean += yards * p;
+        EXPECT_NEAR(analyticMean, sampledMean, 0.1) << advantage;
+    }
+}
+
+TEST(NumberMakerTest, FieldGoalOddsMatchTheTruncatedNormal) {
+    RNG::gen.seed(5);
+    for (int yardLine : { 5, 20, 33 }) {
+        const int kicks = 200000;
+        int tableMade = 0, normalMade = 0;
+        double odds = -0.027 * (3 - (1.5 * 0.6)) * (yardLine * yardLine) + 80 + (20 * 0.7);
+        for (int i = 0; i < kicks; i++) {
+            tableMade += NumberMaker::didFieldGoalSucceed(yardLine, 0.7, 0.6);
+            normalMade += RNG::randomNumberNormalDist(0, 100) < odds;
+        }
+        EXPECT_NEAR((double)tableMade / kicks, (double)normalMade / kicks, 0.006) << yardLine;
+    }
+}
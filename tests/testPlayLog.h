@@ -0,0 +1,144 @@
+#pragma once
+#include <gtest/gtest.h>
+#include <fstream>
+#include "../src/games/gamePlayer.h"
+#include "twoSchoolTest.h"
+
+class PlayLogTest : public TwoSchoolTest {
+protected:
+    PlayLog playGames(int games) {
+        PlayLog log;
+        for (int i = 0; i < games; i++) {
+            std::vector<PlayRecord> snaps;
+            GamePlayer game(schools[i % 2], schools[1 - i % 2]);
+            game.logPlaysTo(&snaps);
+            GameResult result = game.startRealTimeGameLoop(false);
+            log.addGame(i, schools[i % 2]->getName(), schools[1 - i % 2]->getName(), snaps, result.awayStats->points,
+                result.homeStats->points);
+            delete result.awayStats;
+            delete result.homeStats;
+        }
+        return log;
+    }
+};
+
+TEST_F(PlayLogTest, SnapsAddUpToTheScore) {
+    RNG::gen.seed(3);
+    std::srand(3);
+    PlayLog log = playGames(20);
+    PlayLogView view = log.view();
+    ASSERT_EQ(view.numGames, 20u);
+    for (size_t g = 0; g < view.numGames; g++) {
+        const LoggedGame& game = view.games[g];
+        EXPECT_EQ(game.numPlays, 143); // 36 snaps a quarter, less the opening kickoff's
+        int points[2] = { 0, 0 };
+        int lastClock = 0;
+        for (const PlayRecord* p = view.begin(game); p != view.end(game); p++) {
+            if (p == view.begin(game)) {
+                EXPECT_TRUE(p->driveStart);
+            }
+            EXPECT_GT(p->clock, lastClock);
+            lastClock = p->clock;
+            if (p->touchdown) points[p->homeOffense] += 7;
+            if (p->outcome == FIELD_GOAL_SCORED) points[p->homeOffense] += 3;
+        }
+        EXPECT_EQ(points[0], game.awayPoints);
+        EXPECT_EQ(points[1], game.homePoints);
+    }
+}
+
+TEST_F(PlayLogTest, SavedLogsReadBackTheSame) {
+    RNG::gen.seed(4);
+    std::srand(4);
+    PlayLog log = playGames(6);
+    std::string raw = ::testing::TempDir() + "playLogRaw.bin";
+    std::string packed = ::testing::TempDir() + "playLogPacked.bin";
+    ASSERT_TRUE(log.save(raw, false));
+    ASSERT_TRUE(log.save(packed, true));
+
+    auto sameAs = [&](const PlayLogView& other) {
+        PlayLogView mine = log.view();
+        EXPECT_EQ(*other.schoolNames, *mine.schoolNames);
+        ASSERT_EQ(other.numGames, mine.numGames);
+        ASSERT_EQ(other.numPlays, mine.numPlays);
+        EXPECT_EQ(std::memcmp(other.games, mine.games, mine.numGames * sizeof(LoggedGame)), 0);
+        EXPECT_EQ(std::memcmp(other.plays, mine.plays, mine.numPlays * sizeof(PlayRecord)), 0);
+    };
+    MappedPlayLog mapped;
+    ASSERT_TRUE(mapped.open(raw));
+    sameAs(mapped.view());
+    EXPECT_FALSE(MappedPlayLog().open(packed));
+
+    PlayLog loaded;
+    ASSERT_TRUE(loaded.load(packed));
+    sameAs(loaded.view());
+    std::vector<uint8_t> bytes = compressPlays(log.view().plays, log.numPlays());
+    EXPECT_LT(bytes.size(), log.numPlays() * sizeof(PlayRecord));
+    std::vector<PlayRecord> unpacked(log.numPlays());
+    EXPECT_FALSE(decompressPlays(bytes.data(), bytes.size() - 1, unpacked.size(), unpacked.data()));
+    std::remove(raw.c_str());
+    std::remove(packed.c_str());
+}
+
+TEST_F(PlayLogTest, SplitsCountEveryDrive) {
+    RNG::gen.seed(5);
+    std::srand(5);
+    PlayLog log = playGames(10);
+    std::vector<SituationalSplits> splits = situationalSplits(log.view());
+    ASSERT_EQ(splits.size(), 2u);
+    int drives = 0, plays = 0;
+    for (size_t i = 0; i < log.numPlays(); i++) drives += log.view().plays[i].driveStart;
+    for (const SituationalSplits& s : splits) {
+        drives -= s.drives;
+        plays += s.plays;
+        EXPECT_GT(s.thirdDowns, 0);
+        EXPECT_LE(s.thirdDownConversions, s.thirdDowns);
+        EXPECT_LE(s.fourthDownConversions, s.fourthDowns);
+        EXPECT_LE(s.redZoneTouchdowns + s.redZoneFieldGoals, s.redZoneTrips);
+        EXPECT_LE(s.redZoneTrips, s.drives);
+    }
+    EXPECT_EQ(drives, 0);
+    EXPECT_EQ(plays, (int)log.numPlays());
+}
+
+TEST_F(PlayLogTest, TruncatedOrCorruptFilesAreTurnedAway) {
+    RNG::gen.seed(6);
+    PlayLog log = playGames(3);
+    std::string raw = ::testing::TempDir() + "playLogRaw.bin";
+    std::string packed = ::testing::TempDir() + "playLogPacked.bin";
+    std::string broken = ::testing::TempDir() + "playLogBroken.bin";
+    ASSERT_TRUE(log.save(raw, false));
+    ASSERT_TRUE(log.save(packed, true));
+    auto readAll = [](const std::string& path) {
+        std::ifstream in(path, std::ios::binary);
+        return std::vector<char>(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    };
+    std::vector<char> rawBytes = readAll(raw), packedBytes = readAll(packed);
+    // Neither reader should take the file once it's been cut short or had a field set to value
+    auto rejected = [&](std::vector<char> bytes, size_t keep, size_t offset = 0, uint64_t value = 0, size_t width = 0) {
+        bytes.resize(keep);
+        if (width > 0) std::memcpy(bytes.data() + offset, &value, width);
+        std::ofstream(broken, std::ios::binary).write(bytes.data(), bytes.size());
+        PlayLog loaded;
+        MappedPlayLog mapped;
+        return !loaded.load(broken) && !mapped.open(broken);
+    };
+    const size_t numPlays = 24, namesOffset = 32, gamesOffset = 40, playsBytes = 56;
+    uint64_t gamesStart;
+    std::memcpy(&gamesStart, rawBytes.data() + gamesOffset, sizeof(gamesStart));
+
+    EXPECT_FALSE(rejected(rawBytes, rawBytes.size())); // Untouched, it loads
+    EXPECT_TRUE(rejected(rawBytes, 40));
+    EXPECT_TRUE(rejected(rawBytes, rawBytes.size() - 1));
+    EXPECT_TRUE(rejected(rawBytes, rawBytes.size(), namesOffset, gamesStart + 8, 8)); // Names after the games
+    EXPECT_TRUE(rejected(rawBytes, rawBytes.size(), gamesOffset, 1ull << 63, 8));
+    EXPECT_TRUE(rejected(rawBytes, rawBytes.size(), numPlays, 1ull << 61, 8)); // Wraps around when multiplied out
+    EXPECT_TRUE(rejected(rawBytes, rawBytes.size(), gamesStart + 4, 60000, 2)); // A game running off the end of the plays
+    EXPECT_TRUE(rejected(rawBytes, rawBytes.size(), gamesStart + 6, 2, 2));     // An away school that isn't in the log
+    EXPECT_TRUE(rejected(packedBytes, packedBytes.size(), numPlays, 1ull << 40, 8)); // More plays than the bits could hold
+    EXPECT_TRUE(rejected(packedBytes, packedBytes.size(), playsBytes, 1ull << 40, 8));
+    EXPECT_TRUE(rejected(packedBytes, packedBytes.size() - 9));
+    std::remove(raw.c_str());
+    std::remove(packed.c_str());
+    std::remove(broken.c_str());
+}
@@ -17,6 +17,26 @@ TEST(PlayerTestSuite, CreateRatingsVector) {
     EXPECT_EQ(rats[STRENGTH], 46);
 }
 
+TEST(PlayerTestSuite, OutOfPositionOvrMatrix) {
+    std::vector<Player> players;
+    for (Position p : { QB, HB, WR, TE, OL, DL, LB, CB, S, K, P }) {
+        players.push_back(Player("Hello", p, 2, 80, 90, createRatingsVector(p, 80, 0.3), 0.3));
+        players.push_back(Player("World", p, 2, 45, 90, createRatingsVector(p, 45, 0.9), 0.9));
+    }
+    std::vector<Player*> pointers;
+    for (auto& player : players) pointers.push_back(&player);
+    std::vector<std::vector<int>> ovrs = estimateOutOfPositionOvrs(pointers);
+    for (Position p : { QB, HB, WR, TE, OL, DL, LB, CB, S, K, P }) {
+        for (int i = 0; i < (int)players.size(); i++) {
+            EXPECT_EQ(ovrs[p][i], estimateOutOfPositionOvr(players[i].getRatingsVector(), p));
+        }
+    }
+    for (Position p : { QB, HB, WR, TE, OL, DL, LB, CB, S, K, P }) {
+        std::vector<int> ideal = createRatingsVector(p, 99, 0.5);
+        EXPECT_EQ(std::vector<int>(getIdealRatings(p).begin(), getIdealRatings(p).end()), ideal);
+    }
+}
+
 TEST(PlayerTestSuite, YearString) {
     Player p1("Hello", QB, 1, 50, 99, {}, 1.0);
     EXPECT_EQ(p1.getYearString(), "Freshman");
@@ -34,6 +54,33 @@ TEST(PlayerTestSuite, PlayerAgingAndTraining) {
     EXPECT_EQ(p1.getLastTrainingResult(), 11);
 }
 
+TEST(PlayerTestSuite, BatchTrainingMatchesTheOriginalTraining) {
+    for (Position pos : { QB, WR, OL, CB, K }) {
+        std::vector<Player> players;
+        for (int i = 0; i < 12; i++) {
+            double arch = i / 11.0;
+            int ovr = 30 + i * 6;
+            players.push_back(Player("Hello", pos, 1 + i % 4, ovr, ovr + 25, createRatingsVector(pos, ovr, arch), arch));
+        }
+        std::vector<Player*> pointers;
+        for (auto& player : players) pointers.push_back(&player);
+        Player::trainBatch(pointers.data(), pointers.size(), 0.6);
+        for (int i = 0; i < (int)players.size(); i++) {
+            // Player::train from before there was a batch version, worked out from what the player was made with
+            int ovr = 30 + i * 6, potential = ovr + 25, year = 1 + i % 4;
+            double penalty = 3.0 - (0.6 * 4.0);
+            double amount = (potential - ovr) / (5 - year);
+            amount = std::round(amount - penalty);
+            if (ovr + amount > 99) amount = 99 - ovr;
+            EXPECT_EQ(players[i].getLastTrainingResult(), amount);
+            EXPECT_EQ(players[i].getOVR(), ovr + amount);
+            EXPECT_EQ(players[i].getRatingsVector(), createRatingsVector(pos, ovr + amount, i / 11.0));
+        }
+        EXPECT_EQ(players[0].getOVR(), 35); // A freshman gets a quarter of the gap, less the penalty
+        EXPECT_EQ(players[11].getOVR(), 99); // And nobody goes past 99
+    }
+}
+
 TEST(PlayerTestSuite, PlayerInjuries) {
     RNG::setRngOverride(1.0);
     Player p1("Hello", QB, 2, 50, 90, {}, 0.0);
@@ -67,4 +114,5 @@ TEST(PlayerTestSuite, PlayerInjuries) {
     EXPECT_EQ(p1.getWeeksInjured(), 1);
     p1.advanceOneWeek();
     EXPECT_FALSE(p1.isInjured());
+    RNG::overrideSet = false;
 }
\ No newline at end of file
@@ -0,0 +1,108 @@
+#pragma once
+#include <gtest/gtest.h>
+#include "../src/league/playoffProjector.h"
+
+class PlayoffProjectorTest : public ::testing::Test {
+protected:
+    City* city;
+    std::vector<std::vector<School>> conferences;
+    std::vector<std::vector<School::Matchup*>> schedule;
+    std::vector<TeamStats*> stats;
+
+    // Two schools in each championship game division, who play each other in week 1. The first of each pair wins if decided.
+    void SetUp() override {
+        city = new City();
+        conferences.resize(20);
+        schedule.resize(16);
+        int ranking = 1;
+        for (std::pair<Conference, Conference> divisions : CHAMPIONSHIP_GAME_DIVISIONS) {
+            for (Conference division : { divisions.first, divisions.second }) {
+                for (int i = 0; i < 2; i++) {
+                    std::string name = divisionName(division) + std::to_string(i);
+                    conferences[division].emplace_back(name, name, name, city, 5, 25000, 1000000, 20, 1);
+                }
+            }
+        }
+        for (auto& conference : conferences) {
+            for (School& school : conference) {
+                school.setDivision((Conference)(&conference - &conferences[0]));
+                school.resetRankingScore(0.5);
+                school.setRanking(ranking++);
+            }
+        }
+    }
+
+    void scheduleDivisionGames(bool decided) {
+        for (auto& conference : conferences) {
+            if (conference.empty()) continue;
+            School::Matchup* m = new School::Matchup{ &conference[0], &conference[1] };
+            if (decided) {
+                m->gameResult.awayStats = new TeamStats();
+                m->gameResult.homeStats = new TeamStats();
+                m->gameResult.awayStats->points = 28;
+                m->gameResult.homeStats->points = 7;
+                stats.push_back(m->gameResult.awayStats);
+                stats.push_back(m->gameResult.homeStats);
+            }
+            conference[0].assignGame(0, m, true, false);
+            conference[1].assignGame(0, m, true, false);
+            schedule[0].push_back(m);
+        }
+    }
+
+    void TearDown() override {
+        for (School::Matchup* m : schedule[0]) delete m;
+        for (TeamStats* s : stats) delete s;
+        delete city;
+    }
+};
+
+TEST_F(PlayoffProjectorTest, EverySeasonHasFourChampionshipGamesFourPlayoffTeamsAndOneChampion) {
+    scheduleDivisionGames(false);
+    PlayoffOdds odds = PlayoffProjector(conferences, schedule, 0).project(500, 0, 1);
+    EXPECT_EQ(odds.simulations, 500);
+    int championshipGames = 0, playoffs = 0, titles = 0;
+    for (int i = 0; i < (int)odds.schools.size(); i++) {
+        championshipGames += odds.championshipGames[i];
+        playoffs += odds.playoffs[i];
+        titles += odds.titles[i];
+    }
+    EXPECT_EQ(championshipGames, 8 * 500);
+    EXPECT_EQ(playoffs, 4 * 500);
+    EXPECT_EQ(titles, 500);
+    // The projection only works on its own copy of the season
+    for (School::Matchup* m : schedule[0]) EXPECT_EQ(m->gameResult.homeStats, nullptr);
+}
+
+TEST_F(PlayoffProjectorTest, DivisionWinnersAlwaysMakeTheChampionshipGame) {
+    scheduleDivisionGames(true);
+    PlayoffOdds odds = PlayoffProjector(conferences, schedule, 1).project(200, 0, 1);
+    for (int i = 0; i < (int)odds.schools.size(); i++) {
+        bool wonDivision = odds.schools[i]->didIWinAgainst(odds.schools[i + (i % 2 == 0 ? 1 : -1)]);
+        EXPECT_EQ(odds.championshipGames[i], wonDivision ? 200 : 0) << odds.schools[i]->getName();
+    }
+}
+
+TEST_F(PlayoffProjectorTest, SameSeedSameOddsAndStopsOnceIntervalsAreTight) {
+    scheduleDivisionGames(false);
+    PlayoffOdds first = PlayoffProjector(conferences, schedule, 0).project(20000, 0.1, 7);
+    PlayoffOdds second = PlayoffProjector(conferences, schedule, 0).project(20000, 0.1, 7);
+    EXPECT_LT(first.simulations, 20000);
+    EXPECT_LT(first.widestInterval(), 0.1);
+    EXPECT_EQ(first.simulations, second.simulations);
+    EXPECT_EQ(first.titles, second.titles);
+}
+
+TEST_F(PlayoffProjectorTest, LockstepMarginsStillPlayAFullPostseason) {
+    scheduleDivisionGames(false);
+    PlayoffProjector projector(conferences, schedule, 0);
+    projector.useLockstepMargins(32, 3);
+    PlayoffOdds odds = projector.project(200, 0, 1);
+    int playoffs = 0, titles = 0;
+    for (int i = 0; i < (int)odds.schools.size(); i++) {
+        playoffs += odds.playoffs[i];
+        titles += odds.titles[i];
+    }
+    EXPECT_EQ(playoffs, 4 * 200);
+    EXPECT_EQ(titles, 200);
+}
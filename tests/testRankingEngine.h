@@ -0,0 +1,78 @@
+#pragma once
+#include <gtest/gtest.h>
+#include "../src/league/schoolRanker.h"
+
+class RankingEngineTest : public ::testing::Test {
+protected:
+    City* city;
+    std::vector<School*> schools;
+    std::vector<School::Matchup*> matchups;
+    std::vector<TeamStats*> stats;
+
+    // away beats home by margin if margin is positive
+    void playGame(int week, int away, int home, int margin) {
+        School::Matchup* m = new School::Matchup{ schools[away], schools[home] };
+        TeamStats* awayStats = new TeamStats();
+        TeamStats* homeStats = new TeamStats();
+        awayStats->points = 21 + std::max(margin, 0);
+        homeStats->points = 21 + std::max(-margin, 0);
+        m->gameResult.awayStats = awayStats;
+        m->gameResult.homeStats = homeStats;
+        schools[away]->assignGame(week, m);
+        schools[home]->assignGame(week, m);
+        matchups.push_back(m);
+        stats.push_back(awayStats);
+        stats.push_back(homeStats);
+    }
+
+    void SetUp() override {
+        city = new City();
+        for (int i = 0; i < 4; i++) {
+            std::string name = "S" + std::to_string(i);
+            schools.push_back(new School(name, name, name, city, 5, 25000, 1000000, 20, 1));
+        }
+        // A round robin where the lower index always wins
+        playGame(0, 0, 1, 10);
+        playGame(0, 2, 3, 10);
+        playGame(1, 0, 2, 10);
+        playGame(1, 1, 3, 10);
+        playGame(2, 3, 0, -10);
+        playGame(2, 2, 1, -10);
+    }
+
+    void TearDown() override {
+        for (School* school : schools) delete school;
+        for (School::Matchup* m : matchups) delete m;
+        for (TeamStats* s : stats) delete s;
+        delete city;
+    }
+};
+
+TEST_F(RankingEngineTest, ConjugateGradientSolvesAndWarmStarts) {
+    // [4 -1 0; -1 4 -1; 0 -1 4] x = [3 2 3] has x = [1 1 1]
+    std::vector<std::vector<std::pair<int, double>>> rows = { { { 0, 4 }, { 1, -1 } }, { { 0, -1 }, { 1, 4 }, { 2, -1 } }, { { 1, -1 }, { 2, 4 } } };
+    SparseSystem system(rows);
+    std::vector<double> x;
+    EXPECT_GT(system.solve({ 3, 2, 3 }, x), 0);
+    for (double v : x) EXPECT_NEAR(v, 1.0, 1e-9);
+    EXPECT_EQ(system.solve({ 3, 2, 3 }, x), 0);
+}
+
+TEST_F(RankingEngineTest, EveryAlgorithmRanksTheRoundRobinInOrder) {
+    for (RankingAlgorithm algorithm : { RankingAlgorithm::ELO, RankingAlgorithm::MASSEY, RankingAlgorithm::COLLEY, RankingAlgorithm::BLENDED }) {
+        SchoolRanker ranker;
+        ranker.setAlgorithm(algorithm);
+        ranker.resetPoll(schools);
+        for (int week = 1; week <= 3; week++) ranker.rankTeams(week);
+        for (int i = 0; i < 4; i++) EXPECT_EQ(schools[i]->getRanking(), i + 1) << "algorithm " << (int)algorithm;
+    }
+}
+
+TEST_F(RankingEngineTest, ColleyRatingsAverageOneHalf) {
+    RankingEngine engine;
+    engine.reset(schools);
+    std::vector<double> ratings = engine.rate(RankingAlgorithm::COLLEY, 3);
+    double total = 0;
+    for (double r : ratings) total += r;
+    EXPECT_NEAR(total / ratings.size(), 0.5, 1e-9);
+}
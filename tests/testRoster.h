@@ -0,0 +1,95 @@
+#pragma once
+#include <gtest/gtest.h>
+#include "../src/players/roster.h"
+
+class RosterTest : public ::testing::Test {
+protected:
+    Roster roster;
+
+    void SetUp() override {
+        roster.generateRoster(5);
+    }
+};
+
+TEST_F(RosterTest, PositionCountsMatchGeneration) {
+    EXPECT_EQ(roster.getRosterSize(), 70);
+    EXPECT_EQ(roster.getPositionCount(QB), 4);
+    EXPECT_EQ(roster.getPositionCount(OL), 11);
+    EXPECT_EQ(roster.getPositionCount(K), 2);
+    EXPECT_EQ(roster.getAllPlayersAt(WR).size(), 9);
+}
+
+TEST_F(RosterTest, PositionGroupsStaySortedAfterAdding) {
+    roster.addPlayer(playerFactory(QB, 1, 5, 99));
+    roster.addPlayer(playerFactory(QB, 1, 5, 1));
+    PositionView qbs = roster.getAllPlayersAt(QB);
+    EXPECT_EQ(qbs.size(), 6);
+    EXPECT_EQ(qbs[0]->getOVR(), 99);
+    EXPECT_EQ(qbs[qbs.size() - 1]->getOVR(), 1);
+    for (int i = 1; i < qbs.size(); i++) EXPECT_GE(qbs[i - 1]->getOVR(), qbs[i]->getOVR());
+}
+
+TEST_F(RosterTest, PositionGroupsStaySortedAfterGraduationAndTraining) {
+    for (int year = 0; year < 3; year++) {
+        roster.ageAndGraduatePlayers();
+        for (Position p : { QB, HB, WR, TE, OL, DL, LB, CB, S, K, P }) roster.trainPlayersAtPosition(p, 0.5);
+    }
+    int total = 0;
+    for (Position p : { QB, HB, WR, TE, OL, DL, LB, CB, S, K, P }) {
+        PositionView players = roster.getAllPlayersAt(p);
+        total += players.size();
+        for (Player* player : players) EXPECT_EQ(player->getPosition(), p);
+        for (int i = 1; i < players.size(); i++) EXPECT_GE(players[i - 1]->getOVR(), players[i]->getOVR());
+    }
+    EXPECT_EQ(total, roster.getRosterSize());
+}
+
+TEST_F(RosterTest, DepthChartRanksBackupsByOutOfPositionOvr) {
+    roster.organizeDepthChart();
+    for (Position p : { QB, HB, WR, TE, OL, DL, LB, CB, S, K, P }) {
+        const std::vector<Player*>& chart = roster.getDepthChart(p);
+        EXPECT_EQ((int)chart.size(), roster.getRosterSize());
+        int starters = roster.getPositionCount(p);
+        for (int i = 0; i < starters; i++) EXPECT_EQ(chart[i]->getPosition(), p);
+        for (int i = starters + 1; i < (int)chart.size(); i++) {
+            EXPECT_NE(chart[i]->getPosition(), p);
+            EXPECT_GE(estimateOutOfPositionOvr(chart[i - 1]->getRatingsVector(), p), estimateOutOfPositionOvr(chart[i]->getRatingsVector(), p));
+        }
+    }
+}
+
+TEST_F(RosterTest, PlayerAddressesSurviveRosterGrowth) {
+    Player* qb = roster.getAllPlayersAt(QB)[0];
+    PlayerHandle handle = qb->getHandle();
+    for (int i = 0; i < 100; i++) roster.addPlayer(playerFactory(WR, 1, 5));
+    EXPECT_EQ(roster.getPlayer(handle), qb);
+    EXPECT_EQ(roster.getAllPlayersAt(QB)[0], qb);
+}
+
+TEST_F(RosterTest, HandlesGoStaleAfterGraduation) {
+    std::vector<PlayerHandle> seniors;
+    for (Position p : { QB, HB, WR, TE, OL, DL, LB, CB, S, K, P }) {
+        for (Player* player : roster.getAllPlayersAt(p)) {
+            if (player->getYear() == 4) seniors.push_back(player->getHandle());
+        }
+    }
+    ASSERT_FALSE(seniors.empty());
+    roster.ageAndGraduatePlayers();
+    // Refill the roster so that the freed slots get reused
+    for (int i = 0; i < (int)seniors.size(); i++) roster.addPlayer(playerFactory(OL, 1, 5));
+    for (PlayerHandle senior : seniors) EXPECT_EQ(roster.getPlayer(senior), nullptr);
+    EXPECT_EQ(roster.getRosterSize(), 70);
+}
+
+TEST_F(RosterTest, CopiedRosterOwnsItsPlayers) {
+    roster.organizeDepthChart();
+    Roster copy(roster);
+    Player* original = roster.getAllPlayersAt(HB)[0];
+    Player* copied = copy.getAllPlayersAt(HB)[0];
+    EXPECT_NE(original, copied);
+    EXPECT_EQ(copy.getPlayer(original->getHandle()), copied);
+    copy.ageAndGraduatePlayers();
+    EXPECT_EQ(roster.getPlayer(original->getHandle()), original);
+    std::vector<Player*> eleven = copy.getElevenMen({ 5, { { { QB, 1 }, { HB, 1 }, { WR, 3 }, { TE, 1 }, { OL, 5 } } } });
+    for (Player* player : eleven) EXPECT_EQ(copy.getPlayer(player->getHandle()), player);
+}
@@ -60,4 +60,23 @@ TEST_F(SchoolsTest, CoachingStaffGetsCannedAfterBadSeason) {
     s1->assessSelf();
     s1->makeCoachingDecisions();
     for (int i = 0; i < 11; i++) EXPECT_TRUE(s1->isVacant((CoachType)i));
-}
\ No newline at end of file
+}
+TEST_F(SchoolsTest, CoachingEffectsFollowStaffChanges) {
+    auto expectedDevelopment = [&](Position p) {
+        double sum = s1->getCoach(CoachType::HC)->getOvrDevelopment() - 40;
+        sum += s1->getCoach(getPositionalCoachType(p))->getOvrDevelopment() - 40;
+        sum += s1->getCoach(getSecondLevelCoachType(p))->getOvrDevelopment() - 40;
+        return sum / 177.0;
+    };
+    EXPECT_DOUBLE_EQ(s1->getDevelopmentMultiplier(QB), expectedDevelopment(QB));
+
+    Coach* oldCoach = s1->getCoach(CoachType::QB);
+    s1->loseCoach(CoachType::QB);
+    Coach* newCoach = new Coach(false, CoachType::QB);
+    s1->signCoach(newCoach, CoachType::QB);
+    EXPECT_DOUBLE_EQ(s1->getDevelopmentMultiplier(QB), expectedDevelopment(QB));
+    double gametime = (newCoach->getOvrGametime() + s1->getCoach(CoachType::OC)->getOvrGametime() +
+        s1->getCoach(CoachType::HC)->getOvrGametime() - 120) / (59.0 * 3);
+    EXPECT_DOUBLE_EQ(s1->getCoachingEffects().gametime[QB], gametime);
+    delete oldCoach;
+}
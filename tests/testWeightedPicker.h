@@ -0,0 +1,35 @@
+#pragma once
+#include <gtest/gtest.h>
+#include "../src/util.h"
+
+TEST(WeightedPickerTest, DrawsInProportionToWhoeverIsLeft) {
+    RNG::gen.seed(2);
+    std::vector<double> weights = { 1, 2, 3, 4, 0, 5 };
+    WeightedPicker picker(weights);
+    EXPECT_EQ(picker.size(), 5);
+    EXPECT_DOUBLE_EQ(picker.total(), 15);
+    picker.remove(3);
+    EXPECT_EQ(picker.size(), 4);
+    EXPECT_DOUBLE_EQ(picker.total(), 11);
+
+    const int draws = 110000;
+    std::vector<int> counts(6, 0);
+    for (int i = 0; i < draws; i++) counts[picker.draw()]++;
+    EXPECT_EQ(counts[3], 0);
+    EXPECT_EQ(counts[4], 0);
+    for (int i : { 0, 1, 2, 5 }) EXPECT_NEAR((double)counts[i] / draws, weights[i] / 11, 0.005) << i;
+}
+
+TEST(WeightedPickerTest, FindCoversEveryWeightEdgeToEdge) {
+    WeightedPicker picker({ 2, 2, 2 });
+    EXPECT_EQ(picker.find(0), 0);
+    EXPECT_EQ(picker.find(1.999), 0);
+    EXPECT_EQ(picker.find(2), 1);
+    EXPECT_EQ(picker.find(5.999), 2);
+    EXPECT_EQ(picker.find(6), 2); // Past the end settles on the last one in
+    picker.remove(2);
+    EXPECT_EQ(picker.find(4.5), 1);
+    picker.remove(0);
+    picker.remove(1);
+    EXPECT_EQ(picker.size(), 0);
+}
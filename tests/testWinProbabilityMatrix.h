@@ -0,0 +1,49 @@
+#pragma once
+#include <gtest/gtest.h>
+#include "../src/games/winProbabilityMatrix.h"
+#include "twoSchoolTest.h"
+
+class WinProbabilityMatrixTest : public TwoSchoolTest {
+protected:
+    WinProbabilityMatrixTest() { numSchools = 3; }
+};
+
+TEST_F(WinProbabilityMatrixTest, LookupsAreCachedUntilALineupChanges) {
+    WinProbabilityMatrix matrix(20);
+    matrix.reset(schools);
+    double chance = matrix.awayWinChance(schools[0], schools[1]);
+    EXPECT_GE(chance, 0.0);
+    EXPECT_LE(chance, 1.0);
+    EXPECT_EQ(matrix.getGamesPlayed(), 20);
+    EXPECT_EQ(matrix.awayWinChance(schools[0], schools[1]), chance);
+    EXPECT_EQ(matrix.getGamesPlayed(), 20);
+    EXPECT_FALSE(matrix.isFresh(schools[1], schools[0])); // Home and away are separate entries
+
+    matrix.awayWinChance(schools[2], schools[1]);
+    Player* qb = *schools[0]->getRoster()->getAllPlayersAt(QB).begin();
+    qb->setWeeksInjured(2);
+    EXPECT_EQ(matrix.refresh(), 1);
+    EXPECT_FALSE(matrix.isFresh(schools[0], schools[1]));
+    EXPECT_TRUE(matrix.isFresh(schools[2], schools[1]));
+    matrix.awayWinChance(schools[0], schools[1]);
+    EXPECT_EQ(matrix.getGamesPlayed(), 60);
+}
+
+TEST_F(WinProbabilityMatrixTest, PrecomputeFillsEveryPairOnce) {
+    WinProbabilityMatrix matrix(10);
+    matrix.reset(schools);
+    matrix.precomputeAll();
+    EXPECT_EQ(matrix.getGamesPlayed(), 6 * 10);
+    for (School* away : schools) {
+        for (School* home : schools) {
+            if (away != home) {
+                EXPECT_TRUE(matrix.isFresh(away, home));
+            }
+        }
+    }
+    matrix.invalidate(schools[2]);
+    EXPECT_FALSE(matrix.isFresh(schools[0], schools[2]));
+    EXPECT_TRUE(matrix.isFresh(schools[0], schools[1]));
+    matrix.precomputeAll();
+    EXPECT_EQ(matrix.getGamesPlayed(), 10 * 10);
+}
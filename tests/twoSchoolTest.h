@@ -0,0 +1,22 @@
+#pragma once
+#include <gtest/gtest.h>
+#include "../src/school.h"
+
+// Two schools (or numSchools, for suites that set it in their constructor) of rising prestige sharing a city, with the
+// RNG drawing for real (an earlier test may have left it overridden)
+class TwoSchoolTest : public ::testing::Test {
+protected:
+    City* city;
+    std::vector<School*> schools;
+    int numSchools = 2;
+
+    void SetUp() override {
+        RNG::overrideSet = false;
+        city = new City();
+        for (int i = 0; i < numSchools; i++) {
+            std::string name = "S" + std::to_string(i);
+            schools.push_back(new School(name, name, name, city, 2 + 6 * i / (numSchools - 1), 25000, 1000000, 20, 1));
+        }
+    }
+    void TearDown() override { for (School* school : schools) delete school; delete city; }
+};